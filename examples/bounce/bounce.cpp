@@ -20,6 +20,7 @@ public:
     Point2d camera_position = { 0.0, 0.0 };
 
     Point2d ball_position = { 0.0, 0.0 };
+    Point2d ball_previous_position = { 0.0, 0.0 };
     Point2d ball_velocity = { 0.0, 0.0 };
 
     Color ball_color = { 0.8f, 0.8f, 0.8f };
@@ -33,35 +34,19 @@ public:
 public:
 
     void keyboard_handle() {
-        if (get_key_action(Keyboard::Code::W) == Keyboard::Action::Press)
-            ball_velocity.y += 0.01;
+        const Input &input = get_input();
 
-        if (get_key_action(Keyboard::Code::A) == Keyboard::Action::Press)
-            ball_velocity.x -= 0.01;
+        ball_velocity.x += 0.01 * (int(input.is_key_down(Keyboard::Code::D)) - int(input.is_key_down(Keyboard::Code::A)));
+        ball_velocity.y += 0.01 * (int(input.is_key_down(Keyboard::Code::W)) - int(input.is_key_down(Keyboard::Code::S)));
 
-        if (get_key_action(Keyboard::Code::S) == Keyboard::Action::Press)
-            ball_velocity.y -= 0.01;
-
-        if (get_key_action(Keyboard::Code::D) == Keyboard::Action::Press)
-            ball_velocity.x += 0.01;
-
-        if (get_key_action(Keyboard::Code::Up) == Keyboard::Action::Press)
-            camera_position.y += 0.01;
-
-        if (get_key_action(Keyboard::Code::Left) == Keyboard::Action::Press)
-            camera_position.x -= 0.01;
-
-        if (get_key_action(Keyboard::Code::Down) == Keyboard::Action::Press)
-            camera_position.y -= 0.01;
-
-        if (get_key_action(Keyboard::Code::Right) == Keyboard::Action::Press)
-            camera_position.x += 0.01;
+        camera_position.x += 0.01 * (int(input.is_key_down(Keyboard::Code::Right)) - int(input.is_key_down(Keyboard::Code::Left)));
+        camera_position.y += 0.01 * (int(input.is_key_down(Keyboard::Code::Up)) - int(input.is_key_down(Keyboard::Code::Down)));
     }
 
-    void calculate_ball_position() {
+    void calculate_ball_position(const Point2d &position) {
         for (u32 i = 0; i < ball_vertices_count; ++i) {
             double theta = 6.28 * double(i) / ball_vertices_count;
-            ball_vertices[i].point = camera.get_projection() * Point3d(ball_position.x + 0.1 * std::cos(theta), ball_position.y + 0.1 * std::sin(theta), 1.0);
+            ball_vertices[i].point = camera.get_projection() * Point3d(position.x + 0.1 * std::cos(theta), position.y + 0.1 * std::sin(theta), 1.0);
         }
     }
 
@@ -82,24 +67,31 @@ public:
         push_layer<BallLayer>(this);
         push_layer<ImGuiLayer>(this);
         set_frame_limit(60);
+        set_fixed_timestep(milliseconds(10));
     }
 
-    virtual bool OnUpdate(Time elapsed) override {
-        clear({ 0.15, 0.15, 0.15 });
+    virtual void OnFixedUpdate(Time step) override {
+        keyboard_handle();
 
-        camera.set_position(camera_position);
+        ball_previous_position = ball_position;
 
-        auto estimated_position = ball_position + ball_velocity * elapsed.asSeconds();
+        auto estimated_position = ball_position + ball_velocity * step.asSeconds();
 
         if (estimated_position.x >= 0.9 || estimated_position.x <= -0.9)
             ball_velocity.x = -(ball_velocity.x / 2.0);
         else if (estimated_position.y >= 0.9 || estimated_position.y <= -0.9)
             ball_velocity.y = -(ball_velocity.y / 2.0);
         else
-            ball_position = estimated_position, keyboard_handle(), calculate_ball_position();
+            ball_position = estimated_position;
+    }
+
+    virtual bool OnUpdate(Time) override {
+        clear({ 0.15, 0.15, 0.15 });
 
+        camera.set_position(camera_position);
+
+        calculate_ball_position(ball_previous_position + (ball_position - ball_previous_position) * get_interpolation_alpha());
         calculate_ball_color();
-        keyboard_handle();
 
         process_layers();
         swap_buffers();
@@ -156,6 +148,7 @@ public:
             ImGui::Text("Ball velocity: { %lf, %lf }", application->ball_velocity.x, application->ball_velocity.y);
             if (ImGui::Button("Ball reset")) {
                 application->ball_position = { 0.0, 0.0 };
+                application->ball_previous_position = { 0.0, 0.0 };
                 application->ball_velocity = { 0.0, 0.0 };
             }
         }
@@ -42,6 +42,7 @@ public:
     ExampleLayers() : Application("ExampleTexture") {
         push_layer<TextureLayer>(this);
         set_frame_limit(60);
+        set_render_thread(true);
     }
 
     virtual bool OnUpdate(Time) override {
@@ -3,10 +3,23 @@
 
 # include <unified/application/window/window.hpp>
 # include <unified/graphics/render_target.hpp>
+# include <unified/graphics/latency_monitor.hpp>
+# include <unified/graphics/frame_fence.hpp>
+# include <unified/graphics/resource_manager.hpp>
 # include <unified/application/layer.hpp>
+# include <unified/application/event_subscriptions.hpp>
+# include <unified/application/input.hpp>
+# include <unified/application/render_thread.hpp>
 # include <unified/core/clock.hpp>
+# include <unified/core/system/frame_pacer.hpp>
+# include <unified/core/system/job_system.hpp>
+# include <unified/core/system/task_scheduler.hpp>
+# include <unified/core/system/timer_wheel.hpp>
 
+# include <type_traits>
 # include <utility>
+# include <atomic>
+# include <vector>
 # include <deque>
 
 # define BIND_EVENT_FN(method, object) std::bind(method, object, std::placeholders::_1)
@@ -21,7 +34,7 @@ public:
 
     Application(string title = "Unified", VideoMode video_mode = VideoMode(800, 600), u32 style = Window::Resizable);
 
-    virtual ~Application() { }
+    virtual ~Application();
 
     void run();
 
@@ -32,6 +45,64 @@ public:
     UNIFIED_NODISCARD u32 get_frame_limit() const;
     void set_frame_limit(u32);
 
+    UNIFIED_NODISCARD u64 get_missed_frames() const;
+
+    // 0 lets the driver queue as many frames as it wants
+    UNIFIED_NODISCARD u32 get_max_frames_in_flight() const;
+    void set_max_frames_in_flight(u32 frames);
+
+    UNIFIED_NODISCARD Time get_gpu_wait_time() const;
+
+    // destruction queued from any thread is carried out at the end of every frame
+    UNIFIED_NODISCARD UNIFIED_GRAPHICS_NAMESPACE::ResourceManager &get_resource_manager();
+
+    UNIFIED_NODISCARD Time get_fixed_timestep() const;
+    void set_fixed_timestep(Time step, u32 max_steps = 5);
+
+    UNIFIED_NODISCARD double get_interpolation_alpha() const;
+
+    UNIFIED_NODISCARD bool get_idle_mode() const;
+    void set_idle_mode(bool enabled, Time timeout = Time());
+
+    UNIFIED_NODISCARD u32 get_background_frame_limit() const;
+    void set_background_frame_limit(u32 limit);
+
+    UNIFIED_NODISCARD bool is_focused() const;
+
+    void request_redraw();
+
+    UNIFIED_NODISCARD const Input &get_input() const;
+
+    UNIFIED_NODISCARD JobSystem &get_job_system();
+
+    UNIFIED_NODISCARD TaskScheduler &get_task_scheduler();
+
+    // main thread only, callbacks fire at the start of the frame they fall due in
+    UNIFIED_NODISCARD TimerWheel &get_timers();
+
+    UNIFIED_NODISCARD Time get_task_budget() const;
+    void set_task_budget(Time budget);
+
+    // takes effect on the next run(). draws are recorded and executed one frame later on a thread
+    // owning the GL context, any other GL work has to go through RenderTarget::invoke. drawables and
+    // shaders are replayed by reference, so they must not be changed or destroyed before the end of
+    // the frame after the one that drew them. Buffer, Shader and Texture throw when they are used
+    // for GL work from the simulation while the render thread runs
+    UNIFIED_NODISCARD bool get_render_thread() const;
+    void set_render_thread(bool enabled);
+
+    // an empty path stops the recording or the replay
+    void record_input(string path);
+    void replay_input(string path, EventPlayer::Mode mode = EventPlayer::Mode::FullSpeed);
+
+    UNIFIED_NODISCARD bool is_recording() const;
+    UNIFIED_NODISCARD bool is_replaying() const;
+
+    UNIFIED_NODISCARD bool get_latency_monitoring() const;
+    void set_latency_monitoring(bool enabled);
+
+    UNIFIED_NODISCARD const UNIFIED_GRAPHICS_NAMESPACE::LatencyMonitor *get_latency_monitor() const;
+
 public:
 
     UNIFIED_NODISCARD const layers_t &layers() const;
@@ -43,16 +114,42 @@ public:
         return new_layer;
     }
 
+    // layers with subscriptions no longer receive the OnEvent broadcast
+    template <auto _method, class _object>
+    void subscribe(_object *object) {
+        if constexpr (std::is_base_of_v<Layer, _object>) {
+            Layer *layer = static_cast<Layer*>(object);
+            layer->_subscribed = true;
+            _subscriptions.subscribe<_method>(object, layer);
+        } else {
+            _subscriptions.subscribe<_method>(object);
+        }
+    }
+
+    void unsubscribe(Layer *layer);
+
 protected:
 
     UNIFIED_NODISCARD layers_t &layers();
 
-    void process_layer(Layer *layer);
     void process_layers();
 
+    void update_layer(Layer *layer, Time elapsed);
+    void schedule_layers();
+
     void dispatch_layers(EventDispatcher &dispatcher);
 
+    void process_fixed_update(Time elapsed);
+
+    Timestamp begin_render_frame();
+    void end_render_frame(Timestamp input);
+
+    void start_render_thread();
+    void stop_render_thread();
+    void wait_for_redraw();
+
     virtual bool OnUpdate(Time) = 0;
+    virtual void OnFixedUpdate(Time) { }
     virtual void OnEvent(EventDispatcher &dispatcher);
 
 private:
@@ -60,10 +157,51 @@ private:
     u32 _frame_limit;
 
     Clock _frame_clock;
-    Time _frame_duration;
+    Time _frame_elapsed;
+    FramePacer _frame_pacer;
+
+    Time _fixed_timestep;
+    Time _fixed_accumulator;
+    u32 _fixed_max_steps;
+    double _interpolation_alpha;
+
+    bool _idle_mode;
+    Time _idle_timeout;
+    u32 _background_frame_limit;
+    bool _focused;
+    std::atomic<bool> _redraw_requested;
 
     layers_t _layers;
 
+    std::vector<u32> _layer_waves;
+
+    EventSubscriptions _subscriptions;
+
+    Input _input;
+
+    JobSystem _jobs;
+
+    TaskScheduler _tasks;
+    Time _task_budget;
+
+    TimerWheel _timers;
+    Time _timeline;
+
+    EventRecorder *_recorder;
+    EventPlayer *_player;
+
+    UNIFIED_GRAPHICS_NAMESPACE::LatencyMonitor *_latency_monitor;
+    UNIFIED_GRAPHICS_NAMESPACE::FrameFence *_frame_fence;
+
+    UNIFIED_GRAPHICS_NAMESPACE::ResourceManager _resources;
+
+    bool _threaded_rendering;
+    RenderThread *_render_thread;
+    UNIFIED_GRAPHICS_NAMESPACE::CommandList _command_lists[2];
+    u32 _recording;
+
+    void handle_event(EventDispatcher &dispatcher);
+
 };
 
 Application *CreateApplication();
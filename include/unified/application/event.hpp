@@ -2,6 +2,7 @@
 #define _UNIFIED_APPLICATION_EVENT_HPP
 
 # include <unified/core/string.hpp>
+# include <unified/core/timestamp.hpp>
 
 UNIFIED_BEGIN_NAMESPACE
 
@@ -18,12 +19,17 @@ public:
         WindowMove,
         CursorMove,
         MousePress,
+        MouseScroll,
         KeyPress
     };
 
+    static constexpr u32 type_count = static_cast<u32>(Type::KeyPress) + 1;
+
     UNIFIED_NODISCARD virtual const char *get_name() const = 0;
     UNIFIED_NODISCARD virtual Type get_type() const = 0;
 
+    Timestamp timestamp = 0;
+
 };
 
 # define UNIFIED_EVENT_CLASS_TYPE(event_type) \
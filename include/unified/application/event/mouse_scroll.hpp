@@ -0,0 +1,23 @@
+#ifndef _UNIFIED_APPLICATION_EVENT_MOUSE_SCROLL_HPP
+#define _UNIFIED_APPLICATION_EVENT_MOUSE_SCROLL_HPP
+
+# include <unified/application/event.hpp>
+# include <unified/core/math/point2.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+class MouseScrollEvent : public Event
+{
+public:
+
+    MouseScrollEvent(double x, double y);
+
+    UNIFIED_EVENT_CLASS_TYPE(Type::MouseScroll)
+
+    const Point2d offset;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef _UNIFIED_APPLICATION_EVENT_QUEUE_HPP
+#define _UNIFIED_APPLICATION_EVENT_QUEUE_HPP
+
+# include <unified/application/event.hpp>
+
+# include <atomic>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+
+class EventQueue
+{
+public:
+
+    static constexpr u32 capacity = 1024;
+
+    struct Entry
+    {
+        Event::Type type;
+
+        // timestamp of the oldest event folded into this entry
+        Timestamp timestamp;
+        u32 coalesced;
+
+        // cursor position, window position or window size
+        double x, y;
+
+        // key or mouse button, focus and maximize keep their state in code
+        int code, action;
+    };
+
+public:
+
+    EventQueue();
+
+    // producer side, GLFW callbacks. flush() returns whether it moved anything into the ring
+    void push(const Entry &entry);
+    bool flush();
+
+    // consumer side, drained once per frame
+    bool pop(Entry &entry);
+
+    UNIFIED_NODISCARD u64 get_overflowed() const;
+    UNIFIED_NODISCARD u64 get_coalesced() const;
+
+protected:
+
+    bool publish(const Entry &entry);
+    void spill(const Entry &entry);
+
+    Entry _entries[capacity];
+
+    alignas(64) std::atomic<u32> _head;
+    alignas(64) std::atomic<u32> _tail;
+
+    Entry _pending;
+    bool _has_pending;
+
+    // entries that did not fit into the ring, in order. nothing is published to the ring past them
+    std::vector<Entry> _overflow;
+
+    u64 _overflowed;
+    u64 _coalesced;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef _UNIFIED_APPLICATION_EVENT_RECORDER_HPP
+#define _UNIFIED_APPLICATION_EVENT_RECORDER_HPP
+
+# include <unified/application/event_queue.hpp>
+# include <unified/core/string.hpp>
+
+# include <fstream>
+
+UNIFIED_BEGIN_NAMESPACE
+
+// the log is a sequence of frame records (the elapsed time handed to that frame) each followed
+// by the events dispatched during it. only event driven state is reproducible, direct queries
+// such as Window::get_key_action still read the live window
+
+class EventRecorder
+{
+public:
+
+    EventRecorder(string path);
+
+    void begin_frame(Time elapsed);
+    void record(const EventQueue::Entry &entry);
+
+    UNIFIED_NODISCARD u64 get_frame_count() const;
+
+protected:
+
+    std::ofstream _file;
+
+    u64 _frame_count;
+
+};
+
+class EventPlayer
+{
+public:
+
+    enum class Mode
+    {
+        FullSpeed,
+        RealTime
+    };
+
+    EventPlayer(string path, Mode mode = Mode::FullSpeed);
+
+    bool begin_frame(Time &elapsed);
+    bool next(EventQueue::Entry &entry);
+
+    UNIFIED_NODISCARD Mode get_mode() const;
+    UNIFIED_NODISCARD u64 get_frame_count() const;
+
+protected:
+
+    std::ifstream _file;
+
+    Mode _mode;
+    u64 _frame_count;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _UNIFIED_APPLICATION_EVENT_SUBSCRIPTIONS_HPP
+#define _UNIFIED_APPLICATION_EVENT_SUBSCRIPTIONS_HPP
+
+# include <unified/application/event.hpp>
+
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+
+class EventSubscriptions
+{
+public:
+
+    using handler_fn = bool(*)(void*, Event&);
+
+    struct Subscription
+    {
+        const void *owner;
+        void *object;
+        handler_fn handler;
+    };
+
+public:
+
+    EventSubscriptions();
+
+    // _method is a `bool (object::*)(some_event&)`, returning true stops the propagation
+    template <auto _method, class _object>
+    void subscribe(_object *object, const void *owner = nullptr) {
+        using traits = handler_traits<decltype(_method)>;
+        typename traits::object_type *target = object;
+        subscribe(traits::event_type::get_type_static(), static_cast<void*>(target), &invoke<_method>, owner);
+    }
+
+    void subscribe(Event::Type type, void *object, handler_fn handler, const void *owner = nullptr);
+
+    // from inside a handler the subscriptions are only disabled, they are removed once dispatch returns
+    void unsubscribe(const void *owner);
+
+    UNIFIED_NODISCARD bool empty(Event::Type type) const;
+
+    bool dispatch(Event &event);
+
+protected:
+
+    template <class>
+    struct handler_traits;
+
+    template <class _object, class _event>
+    struct handler_traits<bool (_object::*)(_event&)>
+    {
+        using object_type = _object;
+        using event_type = _event;
+    };
+
+    template <auto _method>
+    static bool invoke(void *object, Event &event) {
+        using traits = handler_traits<decltype(_method)>;
+        return (static_cast<typename traits::object_type*>(object)->*_method)(static_cast<typename traits::event_type&>(event));
+    }
+
+    void compact();
+
+    std::vector<Subscription> _table[Event::type_count];
+
+    u32 _dispatching;
+    bool _dirty;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
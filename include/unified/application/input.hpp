@@ -0,0 +1,85 @@
+#ifndef _UNIFIED_APPLICATION_INPUT_HPP
+#define _UNIFIED_APPLICATION_INPUT_HPP
+
+# include <unified/application/event.hpp>
+# include <unified/core/input/keyboard.hpp>
+# include <unified/core/input/mouse.hpp>
+# include <unified/core/math/point2.hpp>
+
+# include <atomic>
+
+UNIFIED_BEGIN_NAMESPACE
+
+// events are accumulated into a back state, which is published each time the window drains its
+// queue. the published state is written into the spare of two fronts and swapped in by index, so
+// a reader still holding the previous front never sees it change under it. edges and deltas last
+// until the frame after the one that published them has run
+class Input
+{
+public:
+
+    static constexpr u32 key_count = 512;
+    static constexpr u32 button_count = 32;
+
+    Input();
+
+    UNIFIED_NODISCARD bool is_key_down(Keyboard::Code code) const { return test(front().keys_down, code); }
+    UNIFIED_NODISCARD bool is_key_pressed(Keyboard::Code code) const { return test(front().keys_pressed, code); }
+    UNIFIED_NODISCARD bool is_key_released(Keyboard::Code code) const { return test(front().keys_released, code); }
+
+    UNIFIED_NODISCARD bool is_button_down(Mouse::Code code) const { return test(front().buttons_down, code); }
+    UNIFIED_NODISCARD bool is_button_pressed(Mouse::Code code) const { return test(front().buttons_pressed, code); }
+    UNIFIED_NODISCARD bool is_button_released(Mouse::Code code) const { return test(front().buttons_released, code); }
+
+    UNIFIED_NODISCARD Point2d get_cursor_position() const { return front().cursor_position; }
+    UNIFIED_NODISCARD Point2d get_cursor_delta() const { return front().cursor_delta; }
+    UNIFIED_NODISCARD Point2d get_scroll() const { return front().scroll; }
+
+    void process_event(EventDispatcher &dispatcher);
+    void publish();
+    // the frame that saw the last publish has run, the next event or publish starts new edges
+    void next_frame();
+
+protected:
+
+    struct State
+    {
+        u64 keys_down[key_count / 64];
+        u64 keys_pressed[key_count / 64];
+        u64 keys_released[key_count / 64];
+
+        u32 buttons_down[1];
+        u32 buttons_pressed[1];
+        u32 buttons_released[1];
+
+        Point2d cursor_position;
+        Point2d cursor_delta;
+        Point2d scroll;
+    };
+
+    // out of range codes (None is -1) wrap onto a bit that is never set, so the lookup needs no branch
+    template <class _word, u32 _count, class _code>
+    static bool test(const _word (&bits)[_count], _code code) {
+        constexpr u32 width = sizeof(_word) * 8;
+        const u32 index = static_cast<u32>(code) & (_count * width - 1);
+        return (bits[index / width] >> (index % width)) & 1;
+    }
+
+    template <class _word, u32 _count>
+    static void assign(_word (&bits)[_count], int code, bool value);
+
+    const State &front() const { return _fronts[_front.load(std::memory_order_acquire)]; }
+    void clear_edges();
+
+    State _fronts[2];
+    std::atomic<u32> _front;
+    State _back;
+
+    bool _has_cursor;
+    bool _stale;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
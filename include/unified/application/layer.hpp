@@ -3,6 +3,7 @@
 
 # include <unified/defines.hpp>
 # include <unified/core/time.hpp>
+# include <unified/core/int_types.hpp>
 
 # include <utility>
 
@@ -23,12 +24,27 @@ protected:
     virtual void OnUpdate(Time) = 0;
     virtual void OnPostUpdate() { };
 
+    virtual void OnFixedUpdate(Time) { }
+    virtual void OnRender(double) { }
+
     virtual void OnEvent(EventDispatcher&) { }
 
+    // each bit names a piece of shared state. a layer that declares its access has its update phase
+    // run on a worker, concurrently with layers it does not conflict with. OnRender stays serial
+    void set_access(u64 reads, u64 writes) { _reads = reads, _writes = writes, _concurrent = true; }
+
 public:
 
     bool active = true;
 
+private:
+
+    bool _subscribed = false;
+
+    u64 _reads = 0;
+    u64 _writes = 0;
+    bool _concurrent = false;
+
 };
 
 UNIFIED_END_NAMESPACE
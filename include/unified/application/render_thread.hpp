@@ -0,0 +1,54 @@
+#ifndef _UNIFIED_APPLICATION_RENDER_THREAD_HPP
+#define _UNIFIED_APPLICATION_RENDER_THREAD_HPP
+
+# include <unified/application/window/window.hpp>
+# include <unified/graphics/render_target.hpp>
+
+# include <condition_variable>
+# include <exception>
+# include <thread>
+# include <utility>
+# include <mutex>
+
+UNIFIED_BEGIN_NAMESPACE
+
+// owns the window's GL context for its lifetime and executes one command list at a time
+class RenderThread
+{
+public:
+
+    RenderThread(const Window &window, const UNIFIED_GRAPHICS_NAMESPACE::RenderTarget &target);
+
+    virtual ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread &operator=(const RenderThread&) = delete;
+
+    // waits for the previous list to finish, then hands this one over and returns. whatever the
+    // previous list threw is rethrown here or from wait() instead
+    void submit(const UNIFIED_GRAPHICS_NAMESPACE::CommandList *commands);
+    void wait();
+
+protected:
+
+    void loop();
+    void rethrow(std::unique_lock<std::mutex> &guard);
+
+    const Window &_window;
+    const UNIFIED_GRAPHICS_NAMESPACE::RenderTarget &_target;
+
+    const UNIFIED_GRAPHICS_NAMESPACE::CommandList *_pending;
+    std::exception_ptr _error;
+    bool _stop;
+
+    std::mutex _lock;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    std::thread _thread;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
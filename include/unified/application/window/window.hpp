@@ -6,11 +6,14 @@
 # include <unified/application/event/window_close.hpp>
 # include <unified/application/event/window_focus.hpp>
 # include <unified/application/event/mouse_press.hpp>
+# include <unified/application/event/mouse_scroll.hpp>
 # include <unified/application/event/window_move.hpp>
 # include <unified/application/event/cursor_move.hpp>
 # include <unified/application/event/key_press.hpp>
 
 # include <unified/application/window/icons/icons.hpp>
+# include <unified/application/event_recorder.hpp>
+# include <unified/core/time.hpp>
 
 # include <functional>
 
@@ -25,6 +28,7 @@ private:
 public:
 
     using event_callback_fn = std::function<void(EventDispatcher&)>;
+    using drain_callback_fn = std::function<void()>;
 
     struct VideoMode
     {
@@ -46,6 +50,8 @@ public:
     virtual ~Window();
 
     bool poll_events() const;
+    bool wait_events(Time timeout = Time()) const;
+    void post_empty_event() const;
 
     void set_title(string title);
     void set_icons(Icons icons);
@@ -63,20 +69,46 @@ public:
 
     void swap_buffers() const;
 
+    // while deferred, swap_buffers() only marks the frame and present() does the swap
+    void set_deferred_swap(bool deferred);
+    bool take_swap_request() const;
+    void present() const;
+
+    void set_context_current(bool current) const;
+
     Keyboard::Action get_key_action(Keyboard::Code code) const;
     Point2d get_cursor_position() const;
 
     void set_event_callback(const event_callback_fn &callback);
+    // runs once the queue is empty, after the last event of a poll or wait was dispatched
+    void set_drain_callback(const drain_callback_fn &callback);
+
+    UNIFIED_NODISCARD const EventQueue &get_event_queue() const;
+
+    void set_event_recorder(EventRecorder *recorder);
+    void set_event_player(EventPlayer *player);
 
 protected:
 
+    void dispatch_events() const;
+    void dispatch_entry(const EventQueue::Entry &entry) const;
+
     string _title;
     glfw_wrapper *_window;
     event_callback_fn _event_callback;
+    drain_callback_fn _drain_callback;
+
+    mutable EventQueue _events;
+
+    EventRecorder *_recorder;
+    EventPlayer *_player;
 
     VideoMode _video_mode;
     bool _vsync;
 
+    bool _deferred_swap;
+    mutable bool _swap_requested;
+
 };
 
 UNIFIED_END_NAMESPACE
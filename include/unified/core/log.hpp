@@ -0,0 +1,208 @@
+#ifndef _UNIFIED_CORE_LOG_HPP
+#define _UNIFIED_CORE_LOG_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/string.hpp>
+# include <unified/core/timestamp.hpp>
+
+# include <fmt/format.h>
+
+# include <cstdio>
+# include <cstring>
+# include <iterator>
+# include <new>
+# include <string_view>
+# include <tuple>
+# include <type_traits>
+# include <utility>
+
+# define UNIFIED_LOG_LEVEL_TRACE    0
+# define UNIFIED_LOG_LEVEL_DEBUG    1
+# define UNIFIED_LOG_LEVEL_INFO     2
+# define UNIFIED_LOG_LEVEL_WARNING  3
+# define UNIFIED_LOG_LEVEL_ERROR    4
+# define UNIFIED_LOG_LEVEL_CRITICAL 5
+# define UNIFIED_LOG_LEVEL_OFF      6
+
+# ifndef UNIFIED_LOG_LEVEL
+#  define UNIFIED_LOG_LEVEL UNIFIED_LOG_LEVEL_INFO
+# endif
+
+UNIFIED_BEGIN_NAMESPACE
+
+// every thread writes into its own ring without locking, a background thread formats and writes
+// the records out. a full ring drops the message instead of stalling the frame
+class Logger
+{
+public:
+
+    enum class Level : u8
+    {
+        Trace,
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Critical
+    };
+
+    static constexpr u32 ring_size = 128 * 1024;
+
+    static void set_sink(std::FILE *sink);
+
+    // on top of UNIFIED_LOG_LEVEL, which removes the calls below it altogether
+    static void set_level(Level level);
+    UNIFIED_NODISCARD static Level get_level();
+
+    // blocks until everything logged before the call has been written
+    static void flush();
+
+    UNIFIED_NODISCARD static u64 get_dropped_count();
+
+    // the format and string arguments are copied into the ring, anything else is kept by value and
+    // formatted on the writer thread
+    template <typename... Args>
+    static void write(Level level, fmt::format_string<Args...> format, Args&&... args);
+
+protected:
+
+    static constexpr u32 alignment = 16;
+
+    using format_fn = void (*)(fmt::memory_buffer &out, std::string_view format, u8 *payload);
+
+    struct Text
+    {
+        u32 offset;
+        u32 size;
+    };
+
+    template <typename T>
+    struct is_text : std::false_type { };
+
+    template <typename T>
+    using stored_t = std::conditional_t<is_text<std::decay_t<T>>::value, Text, std::decay_t<T>>;
+
+    static std::string_view text_of(const char *value) {
+        return value ? std::string_view(value) : std::string_view("(null)");
+    }
+
+    static std::string_view text_of(std::string_view value) {
+        return value;
+    }
+
+    template <typename T>
+    static u32 text_size(const T &value) {
+        if constexpr (is_text<std::decay_t<T>>::value)
+            return static_cast<u32>(text_of(value).size());
+        else
+            return 0;
+    }
+
+    template <typename T>
+    static stored_t<T> store(T &&value, u8 *payload, u32 &cursor) {
+        if constexpr (is_text<std::decay_t<T>>::value) {
+            const std::string_view text = text_of(value);
+            const Text result { cursor, static_cast<u32>(text.size()) };
+
+            std::memcpy(payload + cursor, text.data(), text.size());
+            cursor += result.size;
+
+            return result;
+        } else
+            return std::forward<T>(value);
+    }
+
+    template <typename T>
+    static const T &load(const T &value, const u8*) {
+        return value;
+    }
+
+    static std::string_view load(const Text &text, const u8 *payload) {
+        return std::string_view(reinterpret_cast<const char*>(payload) + text.offset, text.size);
+    }
+
+    template <typename... Stored>
+    static void format_record(fmt::memory_buffer &out, std::string_view format, u8 *payload) {
+        using tuple_t = std::tuple<Stored...>;
+        tuple_t &args = *std::launder(reinterpret_cast<tuple_t*>(payload));
+
+        std::apply([&](const Stored&... values) {
+            fmt::format_to(std::back_inserter(out), fmt::runtime(format), load(values, payload)...);
+        }, args);
+
+        args.~tuple_t();
+    }
+
+    static u8 *reserve(Level level, u32 size, format_fn format, std::string_view text);
+    static void commit();
+
+};
+
+template <> struct Logger::is_text<char*> : std::true_type { };
+template <> struct Logger::is_text<const char*> : std::true_type { };
+template <> struct Logger::is_text<string> : std::true_type { };
+template <> struct Logger::is_text<std::string_view> : std::true_type { };
+
+template <typename... Args>
+void Logger::write(Level level, fmt::format_string<Args...> format, Args&&... args) {
+    if (level < get_level())
+        return;
+
+    using tuple_t = std::tuple<stored_t<Args>...>;
+    static_assert(alignof(tuple_t) <= alignment, "over aligned log argument");
+
+    const u32 texts = (0 + ... + text_size(args));
+
+    const fmt::string_view text = format;
+
+    u8 *payload = reserve(level, static_cast<u32>(sizeof(tuple_t)) + texts, &format_record<stored_t<Args>...>, std::string_view(text.data(), text.size()));
+    if (!payload)
+        return;
+
+    u32 cursor = static_cast<u32>(sizeof(tuple_t));
+    new (payload) tuple_t(store(std::forward<Args>(args), payload, cursor)...);
+
+    commit();
+}
+
+UNIFIED_END_NAMESPACE
+
+# define UNIFIED_LOG(level, ...) ::UNIFIED_NAMESPACE::Logger::write(::UNIFIED_NAMESPACE::Logger::Level::level, __VA_ARGS__)
+
+# if UNIFIED_LOG_LEVEL <= UNIFIED_LOG_LEVEL_TRACE
+#  define UNIFIED_LOG_TRACE(...) UNIFIED_LOG(Trace, __VA_ARGS__)
+# else
+#  define UNIFIED_LOG_TRACE(...) ((void)0)
+# endif
+
+# if UNIFIED_LOG_LEVEL <= UNIFIED_LOG_LEVEL_DEBUG
+#  define UNIFIED_LOG_DEBUG(...) UNIFIED_LOG(Debug, __VA_ARGS__)
+# else
+#  define UNIFIED_LOG_DEBUG(...) ((void)0)
+# endif
+
+# if UNIFIED_LOG_LEVEL <= UNIFIED_LOG_LEVEL_INFO
+#  define UNIFIED_LOG_INFO(...) UNIFIED_LOG(Info, __VA_ARGS__)
+# else
+#  define UNIFIED_LOG_INFO(...) ((void)0)
+# endif
+
+# if UNIFIED_LOG_LEVEL <= UNIFIED_LOG_LEVEL_WARNING
+#  define UNIFIED_LOG_WARNING(...) UNIFIED_LOG(Warning, __VA_ARGS__)
+# else
+#  define UNIFIED_LOG_WARNING(...) ((void)0)
+# endif
+
+# if UNIFIED_LOG_LEVEL <= UNIFIED_LOG_LEVEL_ERROR
+#  define UNIFIED_LOG_ERROR(...) UNIFIED_LOG(Error, __VA_ARGS__)
+# else
+#  define UNIFIED_LOG_ERROR(...) ((void)0)
+# endif
+
+# if UNIFIED_LOG_LEVEL <= UNIFIED_LOG_LEVEL_CRITICAL
+#  define UNIFIED_LOG_CRITICAL(...) UNIFIED_LOG(Critical, __VA_ARGS__)
+# else
+#  define UNIFIED_LOG_CRITICAL(...) ((void)0)
+# endif
+
+#endif
@@ -9,31 +9,31 @@ UNIFIED_BEGIN_NAMESPACE
 
 template <class _type>
 UNIFIED_CONSTEXPR Matrix<_type, 2, 2> inverse(const Matrix<_type, 2, 2> &m) {
-    _type determinant = compute_determinant(m);
+    _type inverse_determinant = _type(1) / compute_determinant(m);
     return Matrix<_type, 2, 2> {
-        { + m[1][1] * determinant, - m[0][1] * determinant },
-        { - m[1][0] * determinant, + m[0][0] * determinant }
+        { + m[1][1] * inverse_determinant, - m[0][1] * inverse_determinant },
+        { - m[1][0] * inverse_determinant, + m[0][0] * inverse_determinant }
     };
 }
 
 template <class _type>
 UNIFIED_CONSTEXPR Matrix<_type, 3, 3> inverse(const Matrix<_type, 3, 3> &m) {
-    _type determinant = compute_determinant(m);
+    _type inverse_determinant = _type(1) / compute_determinant(m);
     return Matrix<_type, 3, 3> {
         {
-            + (m[1][1] * m[2][2] - m[2][1] * m[1][2]) * determinant,
-            - (m[0][1] * m[2][2] - m[2][1] * m[0][2]) * determinant,
-            + (m[0][1] * m[1][2] - m[1][1] * m[0][2]) * determinant
+            + (m[1][1] * m[2][2] - m[2][1] * m[1][2]) * inverse_determinant,
+            - (m[0][1] * m[2][2] - m[2][1] * m[0][2]) * inverse_determinant,
+            + (m[0][1] * m[1][2] - m[1][1] * m[0][2]) * inverse_determinant
         },
         {
-            - (m[1][0] * m[2][2] - m[2][0] * m[1][2]) * determinant,
-            + (m[0][0] * m[2][2] - m[2][0] * m[0][2]) * determinant,
-            - (m[0][0] * m[1][2] - m[1][0] * m[0][2]) * determinant
+            - (m[1][0] * m[2][2] - m[2][0] * m[1][2]) * inverse_determinant,
+            + (m[0][0] * m[2][2] - m[2][0] * m[0][2]) * inverse_determinant,
+            - (m[0][0] * m[1][2] - m[1][0] * m[0][2]) * inverse_determinant
         },
         {
-            + (m[1][0] * m[2][1] - m[2][0] * m[1][1]) * determinant,
-            - (m[0][0] * m[2][1] - m[2][0] * m[0][1]) * determinant,
-            + (m[0][0] * m[1][1] - m[1][0] * m[0][1]) * determinant
+            + (m[1][0] * m[2][1] - m[2][0] * m[1][1]) * inverse_determinant,
+            - (m[0][0] * m[2][1] - m[2][0] * m[0][1]) * inverse_determinant,
+            + (m[0][0] * m[1][1] - m[1][0] * m[0][1]) * inverse_determinant
         }
     };
 }
@@ -0,0 +1,101 @@
+#ifndef _UNIFIED_CORE_MEMORY_FRAME_ARENA_HPP
+#define _UNIFIED_CORE_MEMORY_FRAME_ARENA_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/int_types.hpp>
+
+# include <atomic>
+# include <cstddef>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+
+// bump allocator for data that does not outlive the frame. the blocks are kept across frames and merged
+// into one on reset, so once it has seen the largest frame it stops touching the heap
+class FrameArena
+{
+public:
+
+    static constexpr u64 default_block_size = 256 * 1024;
+
+    FrameArena(u64 block_size = default_block_size);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena &operator=(const FrameArena&) = delete;
+
+    void *allocate(u64 size, u64 alignment = alignof(std::max_align_t));
+
+    // only gives memory back when it was the latest allocation, anything else waits for the reset
+    void deallocate(void *pointer, u64 size);
+
+    void reset();
+
+    UNIFIED_NODISCARD u64 get_used() const;
+    UNIFIED_NODISCARD u64 get_capacity() const;
+
+    // the calling thread's arena, reset on its first use after next_frame().
+    // its memory must not be handed to another frame, the render thread included
+    static FrameArena &local();
+    static void next_frame();
+
+protected:
+
+    struct Block
+    {
+        u8 *data;
+        u64 size;
+    };
+
+    void grow(u64 size);
+
+    std::vector<Block> _blocks;
+
+    u64 _block_size;
+    u64 _offset;
+    u64 _retired;
+
+    u64 _frame;
+
+    static std::atomic<u64> _current_frame;
+
+};
+
+template <typename T>
+class FrameAllocator
+{
+public:
+
+    using value_type = T;
+
+    FrameAllocator() noexcept = default;
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>&) noexcept { }
+
+    T *allocate(std::size_t count) {
+        return static_cast<T*>(FrameArena::local().allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *pointer, std::size_t count) noexcept {
+        FrameArena::local().deallocate(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>&) const noexcept {
+        return false;
+    }
+
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef _UNIFIED_CORE_MEMORY_MEMORY_TRACKER_HPP
+#define _UNIFIED_CORE_MEMORY_MEMORY_TRACKER_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/int_types.hpp>
+
+# include <atomic>
+
+UNIFIED_BEGIN_NAMESPACE
+
+enum class MemoryTag : u8
+{
+    General,
+    Textures,
+    Buffers,
+    Layers,
+    Modules,
+    Count
+};
+
+// heap usage per subsystem is only counted when built with UNIFIED_TRACK_ALLOCATIONS, which replaces the
+// global operator new. gpu bytes are always counted
+class MemoryTracker
+{
+public:
+
+    static constexpr u32 tag_count = static_cast<u32>(MemoryTag::Count);
+
+    struct Counters
+    {
+        u64 bytes;
+        u64 allocations;
+        u64 frees;
+
+        // of the last finished frame
+        u64 frame_bytes;
+        u64 frame_allocations;
+
+        u64 gpu_bytes;
+    };
+
+    UNIFIED_NODISCARD static bool is_tracking();
+
+    UNIFIED_NODISCARD static Counters get_counters(MemoryTag tag);
+    UNIFIED_NODISCARD static u64 get_frame_allocations();
+    UNIFIED_NODISCARD static const char *get_tag_name(MemoryTag tag);
+
+    UNIFIED_NODISCARD static MemoryTag get_current_tag();
+
+    static void record_allocation(MemoryTag tag, u64 size);
+    static void record_free(MemoryTag tag, u64 size);
+    static void record_gpu(MemoryTag tag, s64 delta);
+
+    // once warmed up, any heap allocation outside of a ScopeAllow aborts the program
+    static void set_frame_guard(bool enabled, u32 warmup_frames = 60);
+    UNIFIED_NODISCARD static bool get_frame_guard();
+
+    static void next_frame();
+
+public:
+
+    class ScopeTag
+    {
+    public:
+
+        ScopeTag(MemoryTag tag);
+
+        virtual ~ScopeTag();
+
+    protected:
+
+        MemoryTag _prev;
+
+    };
+
+    class ScopeAllow
+    {
+    public:
+
+        ScopeAllow();
+
+        virtual ~ScopeAllow();
+
+    };
+
+protected:
+
+    struct TagCounters
+    {
+        std::atomic<u64> bytes;
+        std::atomic<u64> allocations;
+        std::atomic<u64> frees;
+        std::atomic<u64> frame_bytes;
+        std::atomic<u64> frame_allocations;
+        std::atomic<u64> last_frame_bytes;
+        std::atomic<u64> last_frame_allocations;
+        std::atomic<s64> gpu_bytes;
+    };
+
+    static TagCounters _counters[tag_count];
+
+    static std::atomic<bool> _guard_enabled;
+    static std::atomic<bool> _guard_armed;
+    static std::atomic<u32> _guard_warmup;
+
+    static thread_local MemoryTag _current_tag;
+    static thread_local u32 _allowed;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef _UNIFIED_CORE_SYSTEM_FRAME_PACER_HPP
+#define _UNIFIED_CORE_SYSTEM_FRAME_PACER_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/time.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+class FramePacer
+{
+public:
+
+    FramePacer();
+
+    UNIFIED_NODISCARD Time get_period() const;
+    void set_period(Time period);
+
+    void reset();
+    Time wait();
+
+    UNIFIED_NODISCARD u64 get_missed_deadlines() const;
+
+protected:
+
+    Time _period;
+    Time _deadline;
+
+    u64 _missed_deadlines;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef _UNIFIED_CORE_SYSTEM_JOB_SYSTEM_HPP
+#define _UNIFIED_CORE_SYSTEM_JOB_SYSTEM_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/int_types.hpp>
+
+# include <condition_variable>
+# include <type_traits>
+# include <cstddef>
+# include <exception>
+# include <utility>
+# include <atomic>
+# include <memory>
+# include <thread>
+# include <vector>
+# include <mutex>
+# include <new>
+
+UNIFIED_BEGIN_NAMESPACE
+
+class JobSystem
+{
+public:
+
+    static constexpr std::size_t job_storage_size = 64;
+
+    // jobs come from a pool grown in blocks and queues never grow, so steady state submission does not
+    // allocate. a job that finds its queue full runs right away instead
+    static constexpr u32 job_block_size = 256;
+    static constexpr u32 queue_capacity = 1024;
+
+protected:
+
+    struct Job;
+
+public:
+
+    enum class Affinity
+    {
+        Any,
+        MainThread
+    };
+
+    // counts the unfinished jobs attached to it, jobs depending on it start once it drops to zero. the
+    // first exception thrown by one of its jobs is kept and rethrown by wait()
+    class Counter
+    {
+    public:
+
+        Counter() : _value(0), _waiters(nullptr), _error() { }
+
+        Counter(const Counter&) = delete;
+        Counter &operator=(const Counter&) = delete;
+
+        UNIFIED_NODISCARD bool done() const { return _value.load(std::memory_order_acquire) == 0; }
+
+    protected:
+
+        friend class JobSystem;
+
+        std::atomic<u32> _value;
+
+        std::mutex _lock;
+        Job *_waiters;
+        std::exception_ptr _error;
+
+    };
+
+public:
+
+    // 0 workers means one per hardware thread besides the calling one
+    JobSystem(u32 workers = 0);
+
+    virtual ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem &operator=(const JobSystem&) = delete;
+
+    template <class _function>
+    void run(_function &&function, Counter *counter = nullptr, Counter *dependency = nullptr, Affinity affinity = Affinity::Any) {
+        using function_type = std::decay_t<_function>;
+        static_assert(sizeof(function_type) <= job_storage_size, "job captures too much state, capture by pointer instead");
+        static_assert(alignof(function_type) <= alignof(std::max_align_t), "job callable is over-aligned");
+
+        Job *job = allocate_job();
+        ::new (static_cast<void*>(job->storage)) function_type(std::forward<_function>(function));
+        job->invoke = [](Job &job, bool execute) {
+            struct ScopeDestroy
+            {
+                function_type &callable;
+                ~ScopeDestroy() { callable.~function_type(); }
+            } destroy { *std::launder(reinterpret_cast<function_type*>(job.storage)) };
+
+            if (execute)
+                destroy.callable();
+        };
+        job->counter = counter;
+        job->affinity = affinity;
+
+        submit(job, dependency);
+    }
+
+    // splits [begin, end) into chunks of grain indices, calls function(index) for each and returns when all are done
+    template <class _function>
+    void parallel_for(u32 begin, u32 end, u32 grain, const _function &function) {
+        if (begin >= end)
+            return;
+
+        grain = grain ? grain : 1;
+        Counter counter;
+
+        for (u32 first = begin; first < end; first += grain) {
+            const u32 last = end - first > grain ? first + grain : end;
+            run([&function, first, last]() {
+                for (u32 index = first; index < last; ++index)
+                    function(index);
+            }, &counter);
+        }
+
+        wait(counter);
+    }
+
+    // runs other jobs while waiting, so it is safe to call from inside a job
+    void wait(Counter &counter);
+
+    // GL and other main thread only work queued with Affinity::MainThread. rethrows what a job without
+    // a counter threw since the last call
+    void process_main_thread_jobs();
+
+    UNIFIED_NODISCARD u32 get_worker_count() const;
+    UNIFIED_NODISCARD bool is_main_thread() const;
+
+    // 0 on the creating thread, 1 to get_worker_count() on the workers. usable to pick per thread storage
+    UNIFIED_NODISCARD u32 get_thread_index() const;
+
+protected:
+
+    struct Job
+    {
+        void (*invoke)(Job&, bool);
+        Counter *counter;
+        Affinity affinity;
+
+        // links the pool's free list and a counter's waiters
+        Job *next;
+
+        alignas(std::max_align_t) unsigned char storage[job_storage_size];
+    };
+
+    // ring of job pointers, the owner works from the back and thieves take from the front
+    struct Queue
+    {
+        std::mutex lock;
+        std::unique_ptr<Job*[]> jobs;
+        u32 capacity, first, count;
+
+        Queue() : jobs(new Job*[queue_capacity]), capacity(queue_capacity), first(0), count(0) { }
+
+        bool push_back(Job *job);
+        Job *pop_back();
+        Job *pop_front();
+        void grow();
+    };
+
+    Job *allocate_job();
+    void free_job(Job *job);
+
+    void submit(Job *job, Counter *dependency);
+    void enqueue(Job *job);
+    void execute(Job *job);
+
+    Job *pop(u32 index);
+    Job *steal(u32 index);
+    Job *acquire(u32 index);
+
+    void worker_loop(u32 index);
+
+    UNIFIED_NODISCARD u32 current_queue() const;
+
+    std::vector<std::thread> _workers;
+
+    // slot 0 belongs to the thread that created the system, the workers own the others
+    std::vector<Queue> _queues;
+    Queue _main_queue;
+
+    std::thread::id _main_thread;
+
+    std::mutex _error_lock;
+    std::exception_ptr _error;
+
+    std::mutex _pool_lock;
+    Job *_free_jobs;
+    std::vector<std::unique_ptr<Job[]>> _job_blocks;
+
+    std::atomic<u32> _queued;
+    std::atomic<bool> _stop;
+
+    std::mutex _sleep_lock;
+    std::condition_variable _sleep;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef _UNIFIED_CORE_SYSTEM_TASK_SCHEDULER_HPP
+#define _UNIFIED_CORE_SYSTEM_TASK_SCHEDULER_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/time.hpp>
+# include <unified/core/string.hpp>
+
+# include <functional>
+# include <vector>
+# include <deque>
+
+UNIFIED_BEGIN_NAMESPACE
+
+// runs resumable tasks in slices on the calling thread until a time budget is spent. a task is called
+// again and again, one small piece of work per call, until it returns true
+class TaskScheduler
+{
+public:
+
+    using Handle = u64;
+    using task_fn = std::function<bool()>;
+
+    static constexpr u32 history_size = 64;
+
+    enum class Priority : u32
+    {
+        Low,
+        Normal,
+        High
+    };
+
+    struct Stats
+    {
+        Handle handle;
+        string name;
+        Priority priority;
+
+        Time runtime;
+        Time longest_slice;
+        u64 slices;
+        u64 frames;
+
+        bool finished;
+        bool missed_deadline;
+    };
+
+public:
+
+    TaskScheduler();
+
+    // the deadline counts from now, a task past it gets a slice every frame even over budget.
+    // tasks may submit and cancel from inside run(), new tasks start on the next one
+    Handle submit(string name, task_fn task, Priority priority = Priority::Normal, Time deadline = Time());
+    bool cancel(Handle handle);
+
+    void run(Time budget);
+
+    UNIFIED_NODISCARD bool is_pending(Handle handle) const;
+    UNIFIED_NODISCARD u32 get_pending_count() const;
+
+    // pending tasks first, then up to history_size finished ones, most recent first
+    UNIFIED_NODISCARD std::vector<Stats> get_stats() const;
+
+protected:
+
+    struct Task
+    {
+        Stats stats;
+        task_fn function;
+        Time deadline;
+        bool cancelled;
+    };
+
+    void slice(Task &task, Time &now);
+    void collect();
+
+    std::vector<Task> _tasks;
+    std::vector<Task> _incoming;
+    std::deque<Stats> _history;
+
+    Handle _next_handle;
+    bool _running;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef _UNIFIED_CORE_SYSTEM_TIMER_WHEEL_HPP
+#define _UNIFIED_CORE_SYSTEM_TIMER_WHEEL_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/time.hpp>
+
+# include <functional>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+
+// hierarchical timing wheel: four levels of 256 slots, each level 256 times coarser than the one below.
+// scheduling and cancelling are O(1), timers are only touched again when their slot comes up.
+// it runs on whatever timeline advance() is fed, starting at zero, so it can follow a replayed clock
+class TimerWheel
+{
+public:
+
+    using Handle = u64;
+    using callback_fn = std::function<void()>;
+
+    static constexpr u32 slot_bits = 8;
+    static constexpr u32 slot_count = 1 << slot_bits;
+    static constexpr u32 level_count = 4;
+
+    TimerWheel(Time resolution = milliseconds(1));
+
+    // the delay counts from the time of the latest advance(). a non zero period makes the timer repeat until cancelled
+    Handle schedule(Time delay, callback_fn callback, Time period = Time());
+    bool cancel(Handle handle);
+
+    // fires everything due up to now, in due order, and returns how many callbacks ran
+    u32 advance(Time now);
+
+    UNIFIED_NODISCARD Time get_time() const;
+
+    UNIFIED_NODISCARD u32 get_count() const;
+
+    // never later than the next expiry, possibly earlier when the next timer sits in a coarse level
+    UNIFIED_NODISCARD Time get_next_due() const;
+
+    UNIFIED_NODISCARD Time get_resolution() const;
+
+protected:
+
+    static constexpr u32 none = ~0u;
+
+    enum class State : u8
+    {
+        Free,
+        Pending,
+        Firing,
+        Cancelled
+    };
+
+    struct Node
+    {
+        callback_fn callback;
+        u64 due;
+        u64 period;
+        u32 generation;
+        u32 slot;
+        u32 prev, next;
+        State state;
+    };
+
+    u32 allocate();
+    void release(u32 index);
+
+    void insert(u32 index);
+    void unlink(u32 index);
+
+    void cascade(u32 level);
+    void expire(u32 slot);
+
+    UNIFIED_NODISCARD u64 to_ticks(Time time) const;
+
+    Time _now;
+    Time _resolution;
+    u64 _current;
+
+    std::vector<Node> _nodes;
+    u32 _free;
+    u32 _count;
+
+    u32 _slots[level_count * slot_count];
+
+    std::vector<u32> _expired;
+
+};
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -9,43 +9,80 @@ class Time
 {
 public:
 
-    Time();
-    explicit Time(u64 microseconds);
+    UNIFIED_CONSTEXPR Time() : _nanoseconds(0) { }
 
-    UNIFIED_NODISCARD double asSeconds() const;
-    UNIFIED_NODISCARD u32 asMilliseconds() const;
-    UNIFIED_NODISCARD u64 asMicroseconds() const;
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR double asSeconds() const {
+        return static_cast<double>(_nanoseconds) / 1000000000.0;
+    }
 
-    UNIFIED_NODISCARD bool operator==(const Time &object) const;
-    UNIFIED_NODISCARD bool operator!=(const Time &object) const;
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR u32 asMilliseconds() const {
+        return static_cast<u32>(_nanoseconds / 1000000);
+    }
 
-    UNIFIED_NODISCARD bool operator>(const Time &object);
-    UNIFIED_NODISCARD bool operator<(const Time &object);
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR u64 asMicroseconds() const {
+        return static_cast<u64>(_nanoseconds / 1000);
+    }
 
-    UNIFIED_NODISCARD bool operator>=(const Time &object);
-    UNIFIED_NODISCARD bool operator<=(const Time &object);
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR s64 asNanoseconds() const {
+        return _nanoseconds;
+    }
 
-    UNIFIED_NODISCARD Time operator+(const Time &object);
-    Time operator+=(const Time &object);
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR bool operator==(const Time &object) const { return _nanoseconds == object._nanoseconds; }
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR bool operator!=(const Time &object) const { return _nanoseconds != object._nanoseconds; }
 
-    UNIFIED_NODISCARD Time operator-(const Time &object);
-    Time operator-=(const Time &object);
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR bool operator>(const Time &object) const { return _nanoseconds > object._nanoseconds; }
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR bool operator<(const Time &object) const { return _nanoseconds < object._nanoseconds; }
 
-    UNIFIED_NODISCARD Time operator*(const Time &object);
-    Time operator*=(const Time &object);
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR bool operator>=(const Time &object) const { return _nanoseconds >= object._nanoseconds; }
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR bool operator<=(const Time &object) const { return _nanoseconds <= object._nanoseconds; }
 
-    UNIFIED_NODISCARD Time operator/(const Time &object);
-    Time operator/=(const Time &object);
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time operator+(const Time &object) const { return Time(_nanoseconds + object._nanoseconds); }
+    UNIFIED_CONSTEXPR Time &operator+=(const Time &object) { _nanoseconds += object._nanoseconds; return *this; }
+
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time operator-(const Time &object) const { return Time(_nanoseconds - object._nanoseconds); }
+    UNIFIED_CONSTEXPR Time &operator-=(const Time &object) { _nanoseconds -= object._nanoseconds; return *this; }
+
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time operator*(s64 factor) const { return Time(_nanoseconds * factor); }
+    UNIFIED_CONSTEXPR Time &operator*=(s64 factor) { _nanoseconds *= factor; return *this; }
+
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time operator*(double factor) const { return Time(static_cast<s64>(static_cast<double>(_nanoseconds) * factor)); }
+    UNIFIED_CONSTEXPR Time &operator*=(double factor) { return *this = *this * factor; }
+
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time operator/(s64 divisor) const { return Time(_nanoseconds / divisor); }
+    UNIFIED_CONSTEXPR Time &operator/=(s64 divisor) { _nanoseconds /= divisor; return *this; }
+
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR double operator/(const Time &object) const {
+        return static_cast<double>(_nanoseconds) / static_cast<double>(object._nanoseconds);
+    }
+
+    UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time operator%(const Time &object) const { return Time(_nanoseconds % object._nanoseconds); }
+    UNIFIED_CONSTEXPR Time &operator%=(const Time &object) { _nanoseconds %= object._nanoseconds; return *this; }
 
 protected:
 
-    u64 _microseconds;
+    UNIFIED_CONSTEXPR explicit Time(s64 nanoseconds) : _nanoseconds(nanoseconds) { }
+
+    friend UNIFIED_CONSTEXPR Time nanoseconds(s64 count);
+
+    s64 _nanoseconds;
 
 };
 
-UNIFIED_NODISCARD Time seconds(double count);
-UNIFIED_NODISCARD Time milliseconds(u32 count);
-UNIFIED_NODISCARD Time microseconds(u64 count);
+UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time nanoseconds(s64 count) {
+    return Time(count);
+}
+
+UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time microseconds(u64 count) {
+    return nanoseconds(static_cast<s64>(count) * 1000);
+}
+
+UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time milliseconds(u32 count) {
+    return nanoseconds(static_cast<s64>(count) * 1000000);
+}
+
+UNIFIED_NODISCARD UNIFIED_CONSTEXPR Time seconds(double count) {
+    return nanoseconds(static_cast<s64>(count * 1000000000.0));
+}
 
 UNIFIED_NODISCARD Time get_current_time();
 
@@ -0,0 +1,33 @@
+#ifndef _UNIFIED_CORE_TIMESTAMP_HPP
+#define _UNIFIED_CORE_TIMESTAMP_HPP
+
+# include <unified/core/time.hpp>
+
+# if defined(UNIFIED_USE_TSC) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#  define UNIFIED_TIMESTAMP_TSC
+#  if defined(_MSC_VER)
+#   include <intrin.h>
+#  else
+#   include <x86intrin.h>
+#  endif
+# endif
+
+UNIFIED_BEGIN_NAMESPACE
+
+typedef u64 Timestamp;
+
+UNIFIED_FORCE_INLINE Timestamp get_timestamp() {
+# if defined(UNIFIED_TIMESTAMP_TSC)
+    return static_cast<Timestamp>(__rdtsc());
+# else
+    return static_cast<Timestamp>(get_current_time().asNanoseconds());
+# endif
+}
+
+UNIFIED_NODISCARD double get_timestamp_frequency();
+
+UNIFIED_NODISCARD Time timestamp_to_time(Timestamp ticks);
+
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef _UNIFIED_GRAPHICS_2D_DRAWABLE_VIRTUAL_TEXTURE_HPP
+#define _UNIFIED_GRAPHICS_2D_DRAWABLE_VIRTUAL_TEXTURE_HPP
+
+# include <unified/graphics/drawable.hpp>
+# include <unified/graphics/primitive_type.hpp>
+
+# include <unified/graphics/buffer.hpp>
+# include <unified/graphics/streaming_texture.hpp>
+# include <unified/graphics/2d/camera.hpp>
+# include <unified/graphics/2d/vertex.hpp>
+
+# include <fstream>
+# include <functional>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_2D_BEGIN_NAMESPACE
+
+class VirtualTexture : public Graphics::Drawable
+{
+public:
+
+    VirtualTexture(string page_file, u32 cache_pages = 256, Graphics::Buffer::Usage usage = Graphics::Buffer::Usage::Dynamic);
+
+    virtual ~VirtualTexture() { }
+
+    // fills one row of rgba pixels, rows are asked for once each, top to bottom
+    using row_reader_fn = std::function<void(u32 row, u8 *pixels)>;
+
+    // qoi images are streamed, anything else has to fit stb_image
+    static void build(string image, string page_file, u32 page_size = 128);
+    static void build(const u8 *pixels, Point2i size, string page_file, u32 page_size = 128);
+    static void build(const row_reader_fn &read_row, Point2i size, string page_file, u32 page_size = 128);
+
+    void set_bounds(const Point2d &position, const Point2d &size);
+    void set_upload_limit(u32 pages);
+
+    // streams in the pages the camera's projection puts on screen
+    void update(const Camera &camera);
+
+    virtual void draw(const Graphics::RenderTarget &target, const Graphics::Shader *shader = 0) const override;
+
+    UNIFIED_NODISCARD Point2i get_size() const;
+    UNIFIED_NODISCARD u32 get_page_size() const;
+    UNIFIED_NODISCARD u32 get_resident_pages() const;
+
+protected:
+
+    struct Header
+    {
+        char magic[4];
+        u32 version;
+        u32 width, height;
+        u32 page_size;
+    };
+
+    struct Slot
+    {
+        s32 page;
+        u64 last_used;
+    };
+
+    static Header read_header(std::ifstream &file);
+
+    s32 acquire_slot();
+    void load_page(s32 page, s32 slot);
+
+    std::ifstream _file;
+    Header _header;
+
+    Point2i _pages;
+    u32 _slot_size, _cache_side;
+
+    Graphics::StreamingTexture _cache;
+    Graphics::StreamingTexture _indirection;
+
+    Graphics::Buffer _buffer;
+
+    std::vector<Slot> _slots;
+    std::vector<s32> _page_slots;
+    std::vector<u8> _table, _staging;
+    bool _table_dirty;
+
+    Point2d _bounds_position, _bounds_size;
+
+    u32 _upload_limit;
+    u64 _frame;
+
+};
+
+UNIFIED_GRAPHICS_2D_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
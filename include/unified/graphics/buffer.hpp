@@ -2,6 +2,7 @@
 #define _UNIFIED_GRAPHICS_BUFFER_HPP
 
 # include <unified/core/int_types.hpp>
+# include <unified/graphics/resource_manager.hpp>
 
 UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
@@ -58,9 +59,12 @@ public:
 
 protected:
 
-    HandleType _id;
+    mutable HandleType _id;
+    ResourceManager::Handle _resource;
     Usage _usage;
 
+    u32 _gpu_size;
+
 };
 
 UNIFIED_GRAPHICS_END_NAMESPACE
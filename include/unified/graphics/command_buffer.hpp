@@ -0,0 +1,59 @@
+#ifndef _UNIFIED_GRAPHICS_COMMAND_BUFFER_HPP
+#define _UNIFIED_GRAPHICS_COMMAND_BUFFER_HPP
+
+# include <unified/graphics/render_target.hpp>
+# include <unified/core/int_types.hpp>
+
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+// draw packets recorded in parallel, one lane per recording thread, then merged and ordered by key
+// for a single threaded replay. a lane must only ever be written by one thread at a time
+class CommandBuffer
+{
+public:
+
+    struct Packet
+    {
+        u64 key;
+        const Drawable *object;
+        const Shader *shader;
+    };
+
+    CommandBuffer(u32 lanes);
+
+    void record(u32 lane, u64 key, const Drawable &object, const Shader *shader = 0);
+
+    // merges every lane into one sequence sorted by key, equal keys keep lane then recording order
+    void sort();
+    void submit(const RenderTarget &target) const;
+    void reset();
+
+    UNIFIED_NODISCARD u32 get_lane_count() const;
+    UNIFIED_NODISCARD u32 size() const;
+
+    // layer in the top bits so whole passes stay together, then the shader to limit program switches
+    UNIFIED_NODISCARD static UNIFIED_CONSTEXPR u64 make_key(u16 layer, u16 shader, u32 depth) {
+        return (static_cast<u64>(layer) << 48) | (static_cast<u64>(shader) << 32) | depth;
+    }
+
+protected:
+
+    struct alignas(64) Lane
+    {
+        std::vector<Packet> packets;
+    };
+
+    std::vector<Lane> _lanes;
+
+    std::vector<Packet> _sorted;
+    std::vector<Packet> _scratch;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
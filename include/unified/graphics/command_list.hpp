@@ -0,0 +1,61 @@
+#ifndef _UNIFIED_GRAPHICS_COMMAND_LIST_HPP
+#define _UNIFIED_GRAPHICS_COMMAND_LIST_HPP
+
+# include <unified/graphics/drawable.hpp>
+# include <unified/graphics/color.hpp>
+# include <unified/core/int_types.hpp>
+
+# include <functional>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+class RenderTarget;
+
+// records render target work so it can be replayed later, possibly on another thread. drawables and
+// shaders are referenced, not copied, so they have to stay alive and unchanged until the list executed
+class CommandList
+{
+public:
+
+    CommandList();
+
+    void clear(const Color &color);
+    void draw(const Drawable &object, const Shader *shader);
+    void invoke(std::function<void()> function);
+
+    void execute(const RenderTarget &target) const;
+    void reset();
+
+    UNIFIED_NODISCARD bool empty() const;
+    UNIFIED_NODISCARD u32 size() const;
+
+protected:
+
+    enum class Type : u32
+    {
+        Clear,
+        Draw,
+        Invoke
+    };
+
+    struct Command
+    {
+        Type type;
+
+        Color color;
+        const Drawable *object;
+        const Shader *shader;
+        u32 function;
+    };
+
+    std::vector<Command> _commands;
+    std::vector<std::function<void()>> _functions;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _UNIFIED_GRAPHICS_CONTEXT_OWNER_HPP
+#define _UNIFIED_GRAPHICS_CONTEXT_OWNER_HPP
+
+# include <unified/defines.hpp>
+
+# include <atomic>
+# include <thread>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+// the thread the GL context is current on. nothing is checked until the context is first handed
+// between threads, from then on Buffer, Shader and Texture refuse GL work from any other thread
+class ContextOwner
+{
+public:
+
+    static void acquire();
+    static void release();
+
+    static void check();
+
+protected:
+
+    static std::atomic<bool> _tracked;
+    static std::atomic<std::thread::id> _owner;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -7,6 +7,7 @@ UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
 
 class RenderTarget;
+class CommandList;
 class Shader;
 
 class Drawable
@@ -14,6 +15,7 @@ class Drawable
 protected:
 
     friend class RenderTarget;
+    friend class CommandList;
 
     virtual ~Drawable();
 
@@ -0,0 +1,50 @@
+#ifndef _UNIFIED_GRAPHICS_FRAME_FENCE_HPP
+#define _UNIFIED_GRAPHICS_FRAME_FENCE_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/time.hpp>
+
+# include <atomic>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+// keeps the driver from queueing more than a fixed number of frames ahead of the GPU
+class FrameFence
+{
+public:
+
+    static constexpr u32 max_frames_in_flight = 8;
+
+    FrameFence(u32 frames_in_flight = 2);
+
+    virtual ~FrameFence();
+
+    UNIFIED_NODISCARD u32 get_frames_in_flight() const;
+    void set_frames_in_flight(u32 frames);
+
+    Time wait();
+    void submit();
+
+    UNIFIED_NODISCARD Time get_last_wait() const;
+    UNIFIED_NODISCARD Time get_total_wait() const;
+
+protected:
+
+    void release_front();
+
+    void *_fences[max_frames_in_flight];
+    u32 _first, _count;
+
+    u32 _frames_in_flight;
+
+    // nanoseconds, written by the thread that owns the context and read by anyone
+    std::atomic<s64> _last_wait;
+    std::atomic<s64> _total_wait;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef _UNIFIED_GRAPHICS_IMAGE_LZ4_HPP
+#define _UNIFIED_GRAPHICS_IMAGE_LZ4_HPP
+
+# include <unified/graphics/texture.hpp>
+
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+namespace Lz4
+{
+    struct Description
+    {
+        u32 width, height;
+        Texture::Format format;
+    };
+
+    UNIFIED_NODISCARD u64 compress_block(const u8 *source, u32 size, std::vector<u8> &destination);
+    void decompress_block(const u8 *source, u32 size, u8 *destination, u32 capacity);
+
+    UNIFIED_NODISCARD bool read_header(const u8 *data, u64 size, Description &description);
+
+    void decode(const u8 *data, u64 size, u8 *pixels, bool flip = false);
+
+    UNIFIED_NODISCARD std::vector<u8> encode(const u8 *pixels, const Description &description);
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
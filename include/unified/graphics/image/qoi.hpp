@@ -0,0 +1,64 @@
+#ifndef _UNIFIED_GRAPHICS_IMAGE_QOI_HPP
+#define _UNIFIED_GRAPHICS_IMAGE_QOI_HPP
+
+# include <unified/core/int_types.hpp>
+
+# include <istream>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+namespace Qoi
+{
+    struct Description
+    {
+        u32 width, height;
+        u8 channels, colorspace;
+    };
+
+    UNIFIED_NODISCARD bool read_header(const u8 *data, u64 size, Description &description);
+
+    void decode(const u8 *data, u64 size, u8 *pixels, bool flip = false);
+
+    UNIFIED_NODISCARD std::vector<u8> encode(const u8 *pixels, const Description &description);
+
+    struct Pixel
+    {
+        u8 r, g, b, a;
+    };
+
+    // decodes a stream a row at a time, for images too large to hold encoded or decoded
+    class Decoder
+    {
+    public:
+
+        Decoder(std::istream &input);
+
+        UNIFIED_NODISCARD const Description &get_description() const;
+
+        // rows come out top to bottom with the channel count of the description
+        void read_row(u8 *pixels);
+
+    protected:
+
+        void refill();
+
+        std::istream &_input;
+        Description _description;
+
+        std::vector<u8> _buffer;
+        u64 _position, _end;
+
+        Pixel _index[64];
+        Pixel _pixel;
+        u32 _run;
+        u32 _row;
+
+    };
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
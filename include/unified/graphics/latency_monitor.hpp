@@ -0,0 +1,71 @@
+#ifndef _UNIFIED_GRAPHICS_LATENCY_MONITOR_HPP
+#define _UNIFIED_GRAPHICS_LATENCY_MONITOR_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/timestamp.hpp>
+
+# include <vector>
+# include <mutex>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+// measures the time from the oldest input consumed by a frame until the GPU finished that frame.
+// input dispatched while frame N polls events is attributed to frame N + 1, the first one drawn after it.
+// end_frame may run on a render thread, the statistics are guarded so they can be read from anywhere
+class LatencyMonitor
+{
+public:
+
+    static constexpr u32 frames_in_flight = 8;
+    static constexpr u32 bucket_count = 2000;
+
+    LatencyMonitor();
+
+    virtual ~LatencyMonitor();
+
+    void consume(Timestamp input);
+
+    Timestamp begin_frame();
+    void end_frame(Timestamp input);
+
+    UNIFIED_NODISCARD Time get_percentile(double percentile) const;
+    UNIFIED_NODISCARD Time get_latest() const;
+    UNIFIED_NODISCARD u64 get_sample_count() const;
+    UNIFIED_NODISCARD u64 get_dropped_count() const;
+
+    UNIFIED_NODISCARD static Time get_bucket_width();
+
+    void reset();
+
+protected:
+
+    struct Frame
+    {
+        Timestamp input;
+        u32 query;
+        void *fence;
+    };
+
+    void collect();
+    void add_sample(Time latency);
+
+    Timestamp _pending_input;
+
+    Frame _frames[frames_in_flight];
+    u32 _first, _count;
+    bool _initialized;
+
+    mutable std::mutex _lock;
+
+    std::vector<u32> _histogram;
+    Time _latest;
+    u64 _samples;
+    u64 _dropped;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
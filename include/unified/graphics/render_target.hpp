@@ -1,8 +1,7 @@
 #ifndef _UNIFIED_GRAPHICS_RENDER_TARGET_HPP
 #define _UNIFIED_GRAPHICS_RENDER_TARGET_HPP
 
-# include <unified/graphics/drawable.hpp>
-# include <unified/graphics/color.hpp>
+# include <unified/graphics/command_list.hpp>
 
 UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
@@ -17,6 +16,16 @@ public:
 
     void draw(const Drawable &object, const Shader *shader = 0) const;
 
+    // runs GL work now, or when the recorded commands are executed
+    void invoke(std::function<void()> function) const;
+
+    UNIFIED_NODISCARD CommandList *get_command_list() const;
+    void set_command_list(CommandList *commands);
+
+protected:
+
+    CommandList *_commands;
+
 };
 
 UNIFIED_GRAPHICS_END_NAMESPACE
@@ -0,0 +1,108 @@
+#ifndef _UNIFIED_GRAPHICS_RESOURCE_MANAGER_HPP
+#define _UNIFIED_GRAPHICS_RESOURCE_MANAGER_HPP
+
+# include <unified/defines.hpp>
+# include <unified/core/int_types.hpp>
+
+# include <mutex>
+# include <thread>
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+// hands out GL names from blocks generated ahead of time and defers their deletion to process(), so
+// objects can be created and destroyed on any thread as long as the GL thread keeps the pools filled.
+// a handle goes stale the moment it is destroyed, its slot is reused with the next generation
+class ResourceManager
+{
+public:
+
+    using Handle = u64;
+
+    enum class Type : u8
+    {
+        Buffer,
+        Texture,
+        Program
+    };
+
+    static constexpr u32 type_count = 3;
+    static constexpr u32 default_block_size = 32;
+
+    // the manager Buffer, Shader and Texture go through, they talk to GL directly while there is none
+    static ResourceManager *current;
+
+    ResourceManager(u32 block_size = default_block_size);
+
+    // on the GL thread, names still owned by live objects are deleted by them
+    virtual ~ResourceManager();
+
+    // only generates names itself when the pool is empty on the GL thread. anywhere else the handle
+    // comes back with name 0 and gets its name from the next process(), or from realize()
+    Handle create(Type type, u32 &name);
+    void destroy(Handle handle);
+
+    UNIFIED_NODISCARD u32 resolve(Handle handle) const;
+
+    // resolve(), but a handle still waiting for its name gets one right away on the GL thread
+    u32 realize(Handle handle);
+
+    // the least a pool is refilled to, a frame that created more raises the next refill to match
+    UNIFIED_NODISCARD u32 get_block_size() const;
+    void set_block_size(u32 block_size);
+
+    // the safe point: deletes what was destroyed since the last call and refills the pools.
+    // whichever thread calls it is taken as the GL thread from then on
+    void process();
+
+    UNIFIED_NODISCARD u32 get_live_count() const;
+    UNIFIED_NODISCARD u32 get_pending_count() const;
+    UNIFIED_NODISCARD u32 get_pooled_count(Type type) const;
+
+    static u32 acquire(Type type, Handle &handle);
+    static void release(Type type, Handle handle, u32 name);
+
+protected:
+
+    struct Slot
+    {
+        u32 name;
+        u32 generation;
+        Type type;
+        bool alive;
+    };
+
+    UNIFIED_NODISCARD const Slot *find(Handle handle) const;
+
+    static void generate(Type type, u32 count, u32 *names);
+    static void remove(Type type, u32 count, const u32 *names);
+
+    mutable std::mutex _mutex;
+
+    std::vector<Slot> _slots;
+    std::vector<u32> _free_slots;
+    u32 _live_count;
+
+    std::vector<u32> _pools[type_count];
+    std::vector<Handle> _pending;
+
+    // created while their pool was empty off the GL thread, and the creations since the last process()
+    std::vector<Handle> _unresolved;
+    u32 _demand[type_count];
+
+    // only touched by process()
+    std::vector<u32> _doomed[type_count];
+    std::vector<u32> _generated;
+
+    u32 _block_size;
+
+    // guarded by _mutex
+    std::thread::id _gl_thread;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
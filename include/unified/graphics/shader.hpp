@@ -2,6 +2,7 @@
 #define _UNIFIED_GRAPHICS_SHADER_HPP
 
 # include <unified/core/string.hpp>
+# include <unified/graphics/resource_manager.hpp>
 
 # include <unified/core/math/matrix_fwd.hpp>
 # include <unified/core/math/point_fwd.hpp>
@@ -90,10 +91,13 @@ public:
 protected:
 
     HandleType _id;
+    ResourceManager::Handle _resource;
 
     void compile(const char *vertex_shader, const char *fragment_shader);
     void free();
 
+    s32 location(const char *name) const;
+
     void throw_if_error(u32 id, u32 type);
 
 };
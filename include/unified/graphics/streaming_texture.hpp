@@ -0,0 +1,52 @@
+#ifndef _UNIFIED_GRAPHICS_STREAMING_TEXTURE_HPP
+#define _UNIFIED_GRAPHICS_STREAMING_TEXTURE_HPP
+
+# include <unified/graphics/texture.hpp>
+
+# include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+class StreamingTexture : public Texture
+{
+public:
+
+    struct Region
+    {
+        Point2i position, size;
+        Region(Point2i position, Point2i size) : position(position), size(size) { }
+    };
+
+    StreamingTexture(Point2i size, Format format = Format::RGBA8, u32 tile_size = 64);
+
+    virtual ~StreamingTexture();
+
+    void update(const void *pixels);
+    void update(const Region &region, const void *pixels);
+
+    UNIFIED_NODISCARD u32 get_tile_size() const;
+    UNIFIED_NODISCARD u32 get_uploaded_tiles() const;
+
+protected:
+
+    bool compare_tile(const Region &tile, const Region &region, const u8 *pixels);
+
+    HandleType _pixel_buffers[2];
+    u32 _pixel_buffer_index;
+
+    u32 _tile_size;
+    Point2i _tiles;
+
+    std::vector<u8> _shadow;
+    std::vector<bool> _valid;
+
+    std::vector<Region> _spans;
+    u32 _uploaded_tiles;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
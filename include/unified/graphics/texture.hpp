@@ -4,10 +4,14 @@
 # include <unified/defines.hpp>
 # include <unified/core/string.hpp>
 # include <unified/core/int_types.hpp>
+# include <unified/core/math/point2.hpp>
+# include <unified/graphics/resource_manager.hpp>
 
 UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
 
+class TextureResidency;
+
 class Texture
 {
 public:
@@ -15,13 +19,30 @@ public:
     using HandleType = u32;
     using SlotType = u32;
 
+    enum class Format : u32
+    {
+        R8, RG8, RGB8, RGBA8,
+        R16, RG16, RGB16, RGBA16,
+        R16F, RG16F, RGB16F, RGBA16F
+    };
+
     Texture(string image, bool flip = false);
     Texture(u8 *data, u32 size, bool flip = false);
+    Texture(Point2i size, Format format = Format::RGBA8);
 
     virtual ~Texture();
 
     HandleType handle() const;
 
+    UNIFIED_NODISCARD Point2i get_size() const;
+    UNIFIED_NODISCARD u32 get_channels() const;
+    UNIFIED_NODISCARD Format get_format() const;
+    UNIFIED_NODISCARD u32 get_pixel_size() const;
+    UNIFIED_NODISCARD static u32 get_pixel_size(Format format);
+    UNIFIED_NODISCARD u64 get_memory_size() const;
+
+    void read(void *buffer) const;
+
     static void bind(const Texture *texture, SlotType slot = 0);
     static void unbind();
 
@@ -40,17 +61,37 @@ public:
     protected:
 
         Texture *_prev;
+        bool _bound;
 
     };
 
 protected:
 
-    HandleType generate_texture(HandleType &id, u32 size, u8 *buffer);
+    friend class TextureResidency;
+
+    HandleType generate_texture(HandleType &id, const void *buffer);
+
+    void load(const u8 *data, u64 size);
+    void specify(const void *buffer);
+    void upload(Point2i position, Point2i size, const void *buffer, u32 row_length = 0);
+
+    void evict();
+    virtual bool reload();
 
     HandleType _id;
+    ResourceManager::Handle _resource;
 
     int _width, _height, _channels;
 
+    Format _format;
+
+    string _source;
+    bool _flip;
+
+    TextureResidency *_residency;
+
+    u64 _gpu_size;
+
 };
 
 UNIFIED_GRAPHICS_END_NAMESPACE
@@ -0,0 +1,75 @@
+#ifndef _UNIFIED_GRAPHICS_TEXTURE_RESIDENCY_HPP
+#define _UNIFIED_GRAPHICS_TEXTURE_RESIDENCY_HPP
+
+# include <unified/graphics/texture.hpp>
+
+# include <unordered_map>
+# include <vector>
+# include <list>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+class TextureResidency
+{
+public:
+
+    TextureResidency(u64 budget);
+
+    virtual ~TextureResidency();
+
+    void manage(Texture *texture);
+    void release(Texture *texture);
+
+    void touch(const Texture *texture);
+
+    // called by the render target after every draw. textures bound since the previous call may all be
+    // in use by the draw being set up, so none of them is evicted to make room for another
+    static void next_draw();
+
+    UNIFIED_NODISCARD bool is_resident(const Texture *texture) const;
+
+    UNIFIED_NODISCARD u64 get_budget() const;
+    void set_budget(u64 budget);
+
+    UNIFIED_NODISCARD u64 get_resident_size() const;
+
+    UNIFIED_NODISCARD u32 get_evictions() const;
+    UNIFIED_NODISCARD u32 get_restores() const;
+
+protected:
+
+    struct Entry
+    {
+        Texture *texture;
+        bool resident;
+        u64 bound_in;
+        std::vector<u8> cache;
+    };
+
+    using entries_t = std::list<Entry>;
+
+    void evict(Entry &entry);
+    void restore(Entry &entry);
+
+    void enforce(const Texture *keep);
+
+    entries_t _entries;
+    std::unordered_map<const Texture*, entries_t::iterator> _lookup;
+
+    u64 _budget;
+    u64 _resident_size;
+
+    u32 _evictions;
+    u32 _restores;
+
+    bool _busy;
+
+    static u64 _draw;
+
+};
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
+
+#endif
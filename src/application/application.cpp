@@ -1,27 +1,116 @@
 #include <unified/application/application.hpp>
 #include <unified/core/system/sleep.hpp>
+#include <unified/core/exceptions.hpp>
+#include <unified/core/memory/frame_arena.hpp>
+#include <unified/core/memory/memory_tracker.hpp>
 #include <glad/glad.h>
 
+#include <algorithm>
+
 UNIFIED_BEGIN_NAMESPACE
 
 Application::Application(string title, VideoMode video_mode, u32 style)
-    : Window(title, video_mode, style), _frame_limit(0), _frame_clock(), _frame_duration(0), _layers() {
-    set_event_callback(BIND_EVENT_FN(&Application::OnEvent, this));
+    : Window(title, video_mode, style), _frame_limit(0), _frame_clock(), _frame_elapsed(), _frame_pacer(),
+      _fixed_timestep(), _fixed_accumulator(), _fixed_max_steps(0), _interpolation_alpha(1.0),
+      _idle_mode(false), _idle_timeout(), _background_frame_limit(10), _focused(true), _redraw_requested(true), _layers(), _layer_waves(), _subscriptions(), _input(), _jobs(), _tasks(), _task_budget(milliseconds(2)), _timers(), _timeline(), _recorder(nullptr), _player(nullptr), _latency_monitor(nullptr), _frame_fence(nullptr), _resources(),
+      _threaded_rendering(false), _render_thread(nullptr), _command_lists(), _recording(0) {
+    set_event_callback(BIND_EVENT_FN(&Application::handle_event, this));
+    // the snapshot follows the drain, so a poll inside OnUpdate is seen by the layers of the same frame
+    set_drain_callback([this]() { _input.publish(); });
+
+    UNIFIED_GRAPHICS_NAMESPACE::ResourceManager::current = &_resources;
+    _resources.process();
+}
+
+Application::~Application() {
+    set_event_recorder(nullptr);
+    set_event_player(nullptr);
+    delete _recorder;
+    delete _player;
+    delete _latency_monitor;
+    delete _frame_fence;
 }
 
 void Application::run() {
     Time elapsed;
-    while (OnUpdate(elapsed)) {
-        elapsed = _frame_clock.get_elapsed_time();
-        _frame_clock.restart();
-        if (_frame_duration > elapsed) {
-            sleep(_frame_duration - elapsed);
+    _frame_pacer.reset();
+    _frame_clock.restart();
+
+    if (_threaded_rendering)
+        start_render_thread();
+
+    // an exception from a frame must not leave the render thread joinable, stopping it while
+    // unwinding only must not throw either
+    struct ScopeRenderThread
+    {
+        explicit ScopeRenderThread(Application &application) : _application(application) { }
+        ~ScopeRenderThread() {
+            if (!_application._render_thread)
+                return;
+            try {
+                _application.stop_render_thread();
+            } catch (...) { }
+        }
+
+        Application &_application;
+    } render_thread(*this);
+
+    for (;;) {
+        if (_player) {
+            if (!_player->begin_frame(elapsed))
+                break;
+            if (_player->get_mode() == EventPlayer::Mode::RealTime && _frame_clock.get_elapsed_time() < elapsed)
+                sleep(elapsed - _frame_clock.get_elapsed_time());
+            _frame_clock.restart();
+        }
+        if (_recorder)
+            _recorder->begin_frame(elapsed);
+
+        const Timestamp input = begin_render_frame();
+
+        _jobs.process_main_thread_jobs();
+        // the timers run on the sum of frame deltas, which a replay reproduces
+        _timeline += elapsed;
+        _timers.advance(_timeline);
+
+        // layers see the frame delta and not the clock, so a replay hands them the logged one
+        _frame_elapsed = elapsed;
+
+        process_fixed_update(elapsed);
+        if (!OnUpdate(elapsed))
+            break;
+        _input.next_frame();
+
+        end_render_frame(input);
+
+        // background work gets whatever is left of the frame up to its budget, and keeps an idle loop awake
+        _tasks.run(_task_budget);
+        if (_tasks.get_pending_count())
+            _redraw_requested.store(true, std::memory_order_release);
+
+        FrameArena::next_frame();
+        MemoryTracker::next_frame();
+
+        // a replay is paced by the log alone
+        if (!_player) {
+            _frame_pacer.wait();
+            if (_idle_mode)
+                wait_for_redraw();
+            elapsed = _frame_clock.get_elapsed_time();
+            _frame_clock.restart();
         }
     }
+
+    if (_render_thread) {
+        // the last submitted list may have failed, that surfaces here and the guard stops the thread
+        _render_thread->wait();
+        stop_render_thread();
+    }
 }
 
 void Application::set_viewport(Point2i size) {
-    glViewport(0, 0, _video_mode.width = size.x, _video_mode.height = size.y);
+    _video_mode.width = size.x, _video_mode.height = size.y;
+    invoke([size]() { glViewport(0, 0, size.x, size.y); });
 }
 
 UNIFIED_NODISCARD u32 Application::get_frame_limit() const {
@@ -29,12 +118,159 @@ UNIFIED_NODISCARD u32 Application::get_frame_limit() const {
 }
 
 void Application::set_frame_limit(u32 limit) {
-    if (limit != 0) {
-        _frame_limit = limit;
-        _frame_duration = seconds(1.0 / _frame_limit);
-    } else {
-        _frame_duration = microseconds(0);
-    }
+    _frame_limit = limit;
+    _frame_pacer.set_period(limit != 0 ? seconds(1.0 / limit) : microseconds(0));
+}
+
+UNIFIED_NODISCARD u64 Application::get_missed_frames() const {
+    return _frame_pacer.get_missed_deadlines();
+}
+
+UNIFIED_NODISCARD u32 Application::get_max_frames_in_flight() const {
+    return _frame_fence ? _frame_fence->get_frames_in_flight() : 0;
+}
+
+void Application::set_max_frames_in_flight(u32 frames) {
+    using UNIFIED_GRAPHICS_NAMESPACE::FrameFence;
+
+    if (frames > FrameFence::max_frames_in_flight)
+        throw Exceptions::misbehavior("bad frames in flight count");
+
+    // the fence may be in use by the render thread, so changes are queued behind the recorded frames
+    FrameFence *fence = _frame_fence;
+    if (!frames)
+        _frame_fence = nullptr, invoke([fence]() { delete fence; });
+    else if (fence)
+        invoke([fence, frames]() { fence->set_frames_in_flight(frames); });
+    else
+        _frame_fence = new FrameFence(frames);
+}
+
+UNIFIED_NODISCARD Time Application::get_gpu_wait_time() const {
+    return _frame_fence ? _frame_fence->get_last_wait() : Time();
+}
+
+UNIFIED_NODISCARD UNIFIED_GRAPHICS_NAMESPACE::ResourceManager &Application::get_resource_manager() {
+    return _resources;
+}
+
+UNIFIED_NODISCARD Time Application::get_fixed_timestep() const {
+    return _fixed_timestep;
+}
+
+void Application::set_fixed_timestep(Time step, u32 max_steps) {
+    _fixed_timestep = step > Time() ? step : Time();
+    _fixed_max_steps = max_steps ? max_steps : 1;
+    _fixed_accumulator = Time();
+    _interpolation_alpha = 1.0;
+}
+
+UNIFIED_NODISCARD double Application::get_interpolation_alpha() const {
+    return _interpolation_alpha;
+}
+
+UNIFIED_NODISCARD bool Application::get_idle_mode() const {
+    return _idle_mode;
+}
+
+void Application::set_idle_mode(bool enabled, Time timeout) {
+    _idle_mode = enabled;
+    _idle_timeout = timeout > Time() ? timeout : Time();
+    request_redraw();
+}
+
+UNIFIED_NODISCARD u32 Application::get_background_frame_limit() const {
+    return _background_frame_limit;
+}
+
+void Application::set_background_frame_limit(u32 limit) {
+    _background_frame_limit = limit;
+}
+
+UNIFIED_NODISCARD bool Application::is_focused() const {
+    return _focused;
+}
+
+void Application::request_redraw() {
+    // safe from any thread, glfwPostEmptyEvent wakes the main thread out of wait_events
+    _redraw_requested.store(true, std::memory_order_release);
+    if (_idle_mode)
+        post_empty_event();
+}
+
+void Application::unsubscribe(Layer *layer) {
+    _subscriptions.unsubscribe(layer);
+    layer->_subscribed = false;
+}
+
+UNIFIED_NODISCARD const Input &Application::get_input() const {
+    return _input;
+}
+
+UNIFIED_NODISCARD JobSystem &Application::get_job_system() {
+    return _jobs;
+}
+
+UNIFIED_NODISCARD TaskScheduler &Application::get_task_scheduler() {
+    return _tasks;
+}
+
+UNIFIED_NODISCARD TimerWheel &Application::get_timers() {
+    return _timers;
+}
+
+UNIFIED_NODISCARD Time Application::get_task_budget() const {
+    return _task_budget;
+}
+
+void Application::set_task_budget(Time budget) {
+    _task_budget = budget;
+}
+
+UNIFIED_NODISCARD bool Application::get_render_thread() const {
+    return _threaded_rendering;
+}
+
+void Application::set_render_thread(bool enabled) {
+    _threaded_rendering = enabled;
+}
+
+void Application::record_input(string path) {
+    set_event_recorder(nullptr);
+    delete _recorder;
+    _recorder = path.empty() ? nullptr : new EventRecorder(path);
+    set_event_recorder(_recorder);
+}
+
+void Application::replay_input(string path, EventPlayer::Mode mode) {
+    set_event_player(nullptr);
+    delete _player;
+    _player = path.empty() ? nullptr : new EventPlayer(path, mode);
+    set_event_player(_player);
+}
+
+UNIFIED_NODISCARD bool Application::is_recording() const {
+    return _recorder != nullptr;
+}
+
+UNIFIED_NODISCARD bool Application::is_replaying() const {
+    return _player != nullptr;
+}
+
+UNIFIED_NODISCARD bool Application::get_latency_monitoring() const {
+    return _latency_monitor != nullptr;
+}
+
+void Application::set_latency_monitoring(bool enabled) {
+    UNIFIED_GRAPHICS_NAMESPACE::LatencyMonitor *monitor = _latency_monitor;
+    if (enabled && !monitor)
+        _latency_monitor = new UNIFIED_GRAPHICS_NAMESPACE::LatencyMonitor();
+    else if (!enabled && monitor)
+        _latency_monitor = nullptr, invoke([monitor]() { delete monitor; });
+}
+
+UNIFIED_NODISCARD const UNIFIED_GRAPHICS_NAMESPACE::LatencyMonitor *Application::get_latency_monitor() const {
+    return _latency_monitor;
 }
 
 const Application::layers_t &Application::layers() const {
@@ -45,25 +281,202 @@ Application::layers_t &Application::layers() {
     return _layers;
 }
 
-void Application::process_layer(Layer *layer) {
-    layer->OnPreUpdate();
-    layer->OnUpdate(_frame_clock.get_elapsed_time());
-    layer->OnPostUpdate();
-}
-
 void Application::process_layers() {
     for (auto it = _layers.begin(); it != _layers.end(); ++it)
-        if ((*it)->active) {
-            process_layer(*it);
-        } else {
+        if (!(*it)->active) {
+            unsubscribe(*it);
             delete *it;
             _layers.erase(it--);
         }
+
+    schedule_layers();
+
+    const Time elapsed = _frame_elapsed;
+    const u32 wave_count = _layer_waves.empty() ? 0 : *std::max_element(_layer_waves.begin(), _layer_waves.end()) + 1;
+
+    FrameVector<Layer*> wave;
+    wave.reserve(_layers.size());
+    for (u32 current = 0; current < wave_count; ++current) {
+        wave.clear();
+        for (std::size_t i = 0; i < _layers.size(); ++i)
+            if (_layer_waves[i] == current)
+                wave.push_back(_layers[i]);
+
+        if (wave.size() == 1 || !wave.front()->_concurrent) {
+            for (Layer *layer : wave)
+                update_layer(layer, elapsed);
+            continue;
+        }
+
+        // jobs come from the system's pool and rings, so a concurrent wave stays off the heap as well
+        JobSystem::Counter counter;
+        for (Layer *layer : wave)
+            _jobs.run([this, layer, elapsed]() { update_layer(layer, elapsed); }, &counter);
+        _jobs.wait(counter);
+    }
+
+    // the render phase submits GL work, so it runs on this thread in layer order
+    MemoryTracker::ScopeTag tag(MemoryTag::Layers);
+    for (Layer *layer : _layers)
+        layer->OnRender(_interpolation_alpha);
+}
+
+void Application::update_layer(Layer *layer, Time elapsed) {
+    MemoryTracker::ScopeTag tag(MemoryTag::Layers);
+
+    layer->OnPreUpdate();
+    layer->OnUpdate(elapsed);
+    layer->OnPostUpdate();
+}
+
+void Application::schedule_layers() {
+    // a layer runs in the wave after the last earlier layer it conflicts with. layers without declared
+    // access conflict with everything, so they keep their place in the order and run alone
+    _layer_waves.assign(_layers.size(), 0);
+
+    for (std::size_t i = 0; i < _layers.size(); ++i) {
+        const Layer *layer = _layers[i];
+        for (std::size_t j = 0; j < i; ++j) {
+            const Layer *other = _layers[j];
+            const bool conflict = !layer->_concurrent || !other->_concurrent
+                || (layer->_writes & (other->_reads | other->_writes)) || (layer->_reads & other->_writes);
+            if (conflict)
+                _layer_waves[i] = std::max(_layer_waves[i], _layer_waves[j] + 1);
+        }
+    }
+}
+
+void Application::process_fixed_update(Time elapsed) {
+    if (_fixed_timestep == Time())
+        return;
+
+    _fixed_accumulator += elapsed;
+
+    for (u32 steps = 0; _fixed_accumulator >= _fixed_timestep && steps < _fixed_max_steps; ++steps) {
+        OnFixedUpdate(_fixed_timestep);
+        for (Layer *layer : _layers)
+            if (layer->active)
+                layer->OnFixedUpdate(_fixed_timestep);
+        _fixed_accumulator -= _fixed_timestep;
+    }
+
+    // past the catch-up limit the backlog is dropped instead of growing every frame
+    if (_fixed_accumulator >= _fixed_timestep)
+        _fixed_accumulator %= _fixed_timestep;
+
+    _interpolation_alpha = _fixed_accumulator / _fixed_timestep;
+}
+
+Timestamp Application::begin_render_frame() {
+    // captured by value, the render thread may still be executing the previous frame with them
+    if (UNIFIED_GRAPHICS_NAMESPACE::FrameFence *fence = _frame_fence)
+        invoke([fence]() { fence->wait(); });
+
+    return _latency_monitor ? _latency_monitor->begin_frame() : 0;
+}
+
+void Application::end_render_frame(Timestamp input) {
+    if (_render_thread && take_swap_request())
+        invoke([this]() { present(); });
+
+    if (UNIFIED_GRAPHICS_NAMESPACE::FrameFence *fence = _frame_fence)
+        invoke([fence]() { fence->submit(); });
+    if (UNIFIED_GRAPHICS_NAMESPACE::LatencyMonitor *monitor = _latency_monitor)
+        invoke([monitor, input]() { monitor->end_frame(input); });
+
+    UNIFIED_GRAPHICS_NAMESPACE::ResourceManager *resources = &_resources;
+    invoke([resources]() { resources->process(); });
+
+    if (!_render_thread)
+        return;
+
+    // returns once the previous list finished, so the other one is free to record into again
+    _render_thread->submit(&_command_lists[_recording]);
+    _recording ^= 1;
+    _command_lists[_recording].reset();
+    set_command_list(&_command_lists[_recording]);
+}
+
+void Application::start_render_thread() {
+    _recording = 0;
+    _command_lists[0].reset();
+    _command_lists[1].reset();
+
+    set_command_list(&_command_lists[_recording]);
+    set_deferred_swap(true);
+
+    _render_thread = new RenderThread(*this, *this);
+}
+
+void Application::stop_render_thread() {
+    delete _render_thread;
+    _render_thread = nullptr;
+
+    set_command_list(nullptr);
+    set_deferred_swap(false);
+
+    // the frame that ended the loop was never submitted, its queued work (deferred deletions) still has to run
+    _command_lists[_recording].execute(*this);
+    _command_lists[0].reset();
+    _command_lists[1].reset();
+}
+
+void Application::wait_for_redraw() {
+    // the frame clock is restarted at the top of every frame, so it measures how long we have been idle
+    const Time throttle = !_focused && _background_frame_limit != 0 ? seconds(1.0 / _background_frame_limit) : Time();
+    Time timeout = _idle_timeout != Time() ? std::max(_idle_timeout, throttle) : Time();
+
+    // the next timer ends the wait as well, the clamp keeps a timer due right now from meaning "no timeout"
+    if (_timers.get_count()) {
+        // the timeline stands where the frame clock was last restarted, so this is in idle time already
+        const Time due = _timers.get_next_due() - _timeline;
+        const Time wake = std::max({ due, throttle, nanoseconds(1) });
+        timeout = timeout != Time() ? std::min(timeout, wake) : wake;
+    }
+
+    for (;;) {
+        const Time idle = _frame_clock.get_elapsed_time();
+
+        if (_redraw_requested.load(std::memory_order_acquire) && idle >= throttle)
+            break;
+        if (timeout != Time() && idle >= timeout)
+            break;
+
+        Time wait = Time();
+        if (_redraw_requested.load(std::memory_order_acquire))
+            wait = throttle - idle;
+        else if (timeout != Time())
+            wait = timeout - idle;
+
+        if (!wait_events(wait))
+            break;
+    }
+
+    _redraw_requested.store(false, std::memory_order_release);
+}
+
+void Application::handle_event(EventDispatcher &dispatcher) {
+    _redraw_requested.store(true, std::memory_order_release);
+
+    dispatcher.dispatch<WindowFocusEvent>([this](WindowFocusEvent &event) {
+        _focused = event.focused;
+    });
+
+    _input.process_event(dispatcher);
+
+    if (_latency_monitor)
+        _latency_monitor->consume(dispatcher.get_event<Event>().timestamp);
+
+    OnEvent(dispatcher);
 }
 
 void Application::dispatch_layers(EventDispatcher &dispatcher) {
+    if (_subscriptions.dispatch(dispatcher.get_event<Event>()))
+        return;
+
     for (Layer *&layer : _layers)
-        layer->OnEvent(dispatcher);
+        if (!layer->_subscribed)
+            layer->OnEvent(dispatcher);
 }
 
 void Application::OnEvent(EventDispatcher &dispatcher) {
@@ -0,0 +1,7 @@
+#include <unified/application/event/mouse_scroll.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+MouseScrollEvent::MouseScrollEvent(double x, double y) : offset(x, y) { }
+
+UNIFIED_END_NAMESPACE
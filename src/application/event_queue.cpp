@@ -0,0 +1,104 @@
+#include <unified/application/event_queue.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+namespace {
+
+    bool is_coalescible(Event::Type type) {
+        return type == Event::Type::CursorMove || type == Event::Type::WindowResize || type == Event::Type::WindowMove;
+    }
+
+}
+
+EventQueue::EventQueue() : _head(0), _tail(0), _pending(), _has_pending(false), _overflow(), _overflowed(0), _coalesced(0) { }
+
+void EventQueue::push(const Entry &entry) {
+    // only the latest position or size matters, so repeated events of the same kind overwrite
+    // the pending one and keep the oldest timestamp for latency measurements
+    if (_has_pending && _pending.type == entry.type) {
+        const Timestamp timestamp = _pending.timestamp;
+        const u32 coalesced = _pending.coalesced + 1;
+        _pending = entry;
+        _pending.timestamp = timestamp;
+        _pending.coalesced = coalesced;
+        ++_coalesced;
+        return;
+    }
+
+    flush();
+
+    if (is_coalescible(entry.type)) {
+        _pending = entry;
+        _pending.coalesced = 0;
+        _has_pending = true;
+    } else if (!_overflow.empty() || !publish(entry)) {
+        spill(entry);
+    }
+}
+
+bool EventQueue::flush() {
+    // the overflow goes first, whatever the consumer made room for since the last flush
+    size_t moved = 0;
+    while (moved < _overflow.size() && publish(_overflow[moved]))
+        ++moved;
+    _overflow.erase(_overflow.begin(), _overflow.begin() + moved);
+
+    bool published = moved != 0;
+    if (_has_pending) {
+        if (_overflow.empty() && publish(_pending))
+            published = true;
+        else
+            spill(_pending);
+        _has_pending = false;
+    }
+
+    return published;
+}
+
+bool EventQueue::pop(Entry &entry) {
+    const u32 head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire))
+        return false;
+
+    entry = _entries[head % capacity];
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+UNIFIED_NODISCARD u64 EventQueue::get_overflowed() const {
+    return _overflowed;
+}
+
+UNIFIED_NODISCARD u64 EventQueue::get_coalesced() const {
+    return _coalesced;
+}
+
+bool EventQueue::publish(const Entry &entry) {
+    const u32 tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) == capacity)
+        return false;
+
+    _entries[tail % capacity] = entry;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+void EventQueue::spill(const Entry &entry) {
+    // a full ring must not lose a key or button release, so nothing is dropped. a position or size
+    // still only keeps its latest value, folded into the previous overflow entry of the same kind
+    if (is_coalescible(entry.type) && !_overflow.empty() && _overflow.back().type == entry.type) {
+        Entry &last = _overflow.back();
+        const Timestamp timestamp = last.timestamp;
+        const u32 coalesced = last.coalesced + entry.coalesced + 1;
+        last = entry;
+        last.timestamp = timestamp;
+        last.coalesced = coalesced;
+        ++_coalesced;
+        return;
+    }
+
+    _overflow.push_back(entry);
+    ++_overflowed;
+}
+
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,119 @@
+#include <unified/application/event_recorder.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <cstring>
+
+UNIFIED_BEGIN_NAMESPACE
+
+namespace {
+
+    using UNIFIED_NAMESPACE::u8;
+    using UNIFIED_NAMESPACE::u32;
+    using UNIFIED_NAMESPACE::s32;
+    using UNIFIED_NAMESPACE::s64;
+
+    UNIFIED_CONSTEXPR char log_magic[4] = { 'U', 'R', 'E', 'C' };
+    UNIFIED_CONSTEXPR u32 log_version = 1;
+
+    enum Tag : u8
+    {
+        FrameTag = 'F',
+        EventTag = 'E'
+    };
+
+    template <class _type>
+    void write(std::ofstream &file, const _type &value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <class _type>
+    bool read(std::ifstream &file, _type &value) {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+}
+
+EventRecorder::EventRecorder(string path) : _file(path, std::ios::binary | std::ios::trunc), _frame_count(0) {
+    if (!_file)
+        throw Exceptions::initialization_failed("failed to create event log");
+
+    _file.write(log_magic, sizeof(log_magic));
+    write(_file, log_version);
+}
+
+void EventRecorder::begin_frame(Time elapsed) {
+    write(_file, FrameTag);
+    write(_file, elapsed.asNanoseconds());
+    ++_frame_count;
+}
+
+void EventRecorder::record(const EventQueue::Entry &entry) {
+    write(_file, EventTag);
+    write(_file, static_cast<u8>(entry.type));
+    write(_file, static_cast<s32>(entry.code));
+    write(_file, static_cast<s32>(entry.action));
+    write(_file, entry.x);
+    write(_file, entry.y);
+}
+
+UNIFIED_NODISCARD u64 EventRecorder::get_frame_count() const {
+    return _frame_count;
+}
+
+EventPlayer::EventPlayer(string path, Mode mode) : _file(path, std::ios::binary), _mode(mode), _frame_count(0) {
+    char magic[sizeof(log_magic)];
+    u32 version = 0;
+
+    if (!_file || !_file.read(magic, sizeof(magic)) || !read(_file, version))
+        throw Exceptions::initialization_failed("failed to read event log");
+
+    if (std::memcmp(magic, log_magic, sizeof(magic)) != 0 || version != log_version)
+        throw Exceptions::initialization_failed("bad event log");
+}
+
+bool EventPlayer::begin_frame(Time &elapsed) {
+    // events the application did not poll during the previous frame are dropped, as they would have been live
+    EventQueue::Entry skipped;
+    while (next(skipped)) { }
+
+    u8 tag = 0;
+    s64 count = 0;
+
+    if (!read(_file, tag) || tag != FrameTag || !read(_file, count))
+        return false;
+
+    elapsed = nanoseconds(count);
+    ++_frame_count;
+    return true;
+}
+
+bool EventPlayer::next(EventQueue::Entry &entry) {
+    if (_file.peek() != EventTag)
+        return false;
+    _file.get();
+
+    u8 type = 0;
+    s32 code = 0, action = 0;
+
+    if (!read(_file, type) || !read(_file, code) || !read(_file, action) || !read(_file, entry.x) || !read(_file, entry.y))
+        return false;
+
+    if (type >= Event::type_count)
+        throw Exceptions::misbehavior("bad event in event log");
+
+    entry.type = static_cast<Event::Type>(type);
+    entry.timestamp = get_timestamp();
+    entry.coalesced = 0;
+    entry.code = code, entry.action = action;
+    return true;
+}
+
+UNIFIED_NODISCARD EventPlayer::Mode EventPlayer::get_mode() const {
+    return _mode;
+}
+
+UNIFIED_NODISCARD u64 EventPlayer::get_frame_count() const {
+    return _frame_count;
+}
+
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,65 @@
+#include <unified/application/event_subscriptions.hpp>
+
+#include <algorithm>
+
+UNIFIED_BEGIN_NAMESPACE
+
+EventSubscriptions::EventSubscriptions() : _table(), _dispatching(0), _dirty(false) { }
+
+void EventSubscriptions::subscribe(Event::Type type, void *object, handler_fn handler, const void *owner) {
+    _table[static_cast<u32>(type)].push_back({ owner, object, handler });
+}
+
+void EventSubscriptions::unsubscribe(const void *owner) {
+    // erasing now would shift the table under a running dispatch and skip the next subscriber
+    if (_dispatching) {
+        for (auto &subscriptions : _table)
+            for (Subscription &subscription : subscriptions)
+                if (subscription.owner == owner)
+                    subscription.handler = nullptr, _dirty = true;
+        return;
+    }
+
+    for (auto &subscriptions : _table)
+        subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(), [owner](const Subscription &subscription) {
+            return subscription.owner == owner;
+        }), subscriptions.end());
+}
+
+UNIFIED_NODISCARD bool EventSubscriptions::empty(Event::Type type) const {
+    const std::vector<Subscription> &subscriptions = _table[static_cast<u32>(type)];
+    return std::none_of(subscriptions.begin(), subscriptions.end(), [](const Subscription &subscription) {
+        return subscription.handler != nullptr;
+    });
+}
+
+bool EventSubscriptions::dispatch(Event &event) {
+    struct ScopeDispatch
+    {
+        explicit ScopeDispatch(EventSubscriptions &subscriptions) : _subscriptions(subscriptions) { ++_subscriptions._dispatching; }
+        ~ScopeDispatch() {
+            if (!--_subscriptions._dispatching && _subscriptions._dirty)
+                _subscriptions.compact();
+        }
+
+        EventSubscriptions &_subscriptions;
+    } scope(*this);
+
+    const std::vector<Subscription> &subscriptions = _table[static_cast<u32>(event.get_type())];
+
+    // indexed on purpose, a handler is allowed to subscribe while we are iterating
+    for (std::size_t i = 0; i < subscriptions.size(); ++i)
+        if (subscriptions[i].handler && subscriptions[i].handler(subscriptions[i].object, event))
+            return true;
+    return false;
+}
+
+void EventSubscriptions::compact() {
+    for (auto &subscriptions : _table)
+        subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(), [](const Subscription &subscription) {
+            return !subscription.handler;
+        }), subscriptions.end());
+    _dirty = false;
+}
+
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,83 @@
+#include <unified/application/input.hpp>
+
+#include <unified/application/event/cursor_move.hpp>
+#include <unified/application/event/mouse_press.hpp>
+#include <unified/application/event/mouse_scroll.hpp>
+#include <unified/application/event/key_press.hpp>
+
+#include <cstring>
+
+UNIFIED_BEGIN_NAMESPACE
+
+Input::Input() : _fronts(), _front(0), _back(), _has_cursor(false), _stale(false) { }
+
+void Input::process_event(EventDispatcher &dispatcher) {
+    if (_stale)
+        clear_edges();
+
+    dispatcher.dispatch<KeyPressEvent>([this](KeyPressEvent &event) {
+        const int code = static_cast<int>(event.code);
+        if (event.action == Keyboard::Action::Press)
+            assign(_back.keys_down, code, true), assign(_back.keys_pressed, code, true);
+        else if (event.action == Keyboard::Action::Release)
+            assign(_back.keys_down, code, false), assign(_back.keys_released, code, true);
+    });
+
+    dispatcher.dispatch<MousePressEvent>([this](MousePressEvent &event) {
+        const int code = static_cast<int>(event.code);
+        if (event.action == Mouse::Action::Press)
+            assign(_back.buttons_down, code, true), assign(_back.buttons_pressed, code, true);
+        else
+            assign(_back.buttons_down, code, false), assign(_back.buttons_released, code, true);
+    });
+
+    dispatcher.dispatch<CursorMoveEvent>([this](CursorMoveEvent &event) {
+        if (_has_cursor)
+            _back.cursor_delta += event.position - _back.cursor_position;
+        _back.cursor_position = event.position;
+        _has_cursor = true;
+    });
+
+    dispatcher.dispatch<MouseScrollEvent>([this](MouseScrollEvent &event) {
+        _back.scroll += event.offset;
+    });
+}
+
+void Input::publish() {
+    if (_stale)
+        clear_edges();
+
+    const u32 spare = _front.load(std::memory_order_relaxed) ^ 1;
+    _fronts[spare] = _back;
+    _front.store(spare, std::memory_order_release);
+}
+
+void Input::next_frame() {
+    _stale = true;
+}
+
+void Input::clear_edges() {
+    // levels carry over to the next frame, edges and deltas start from zero
+    std::memset(_back.keys_pressed, 0, sizeof(_back.keys_pressed));
+    std::memset(_back.keys_released, 0, sizeof(_back.keys_released));
+    std::memset(_back.buttons_pressed, 0, sizeof(_back.buttons_pressed));
+    std::memset(_back.buttons_released, 0, sizeof(_back.buttons_released));
+    _back.cursor_delta = Point2d();
+    _back.scroll = Point2d();
+    _stale = false;
+}
+
+template <class _word, u32 _count>
+void Input::assign(_word (&bits)[_count], int code, bool value) {
+    constexpr u32 width = sizeof(_word) * 8;
+    if (code < 0 || static_cast<u32>(code) >= _count * width - 1)
+        return;
+
+    const _word mask = _word(1) << (static_cast<u32>(code) % width);
+    if (value)
+        bits[code / width] |= mask;
+    else
+        bits[code / width] &= ~mask;
+}
+
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,83 @@
+#include <unified/application/render_thread.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+RenderThread::RenderThread(const Window &window, const UNIFIED_GRAPHICS_NAMESPACE::RenderTarget &target)
+    : _window(window), _target(target), _pending(nullptr), _error(), _stop(false) {
+    // a context can only be current on one thread at a time
+    _window.set_context_current(false);
+    _thread = std::thread(&RenderThread::loop, this);
+}
+
+RenderThread::~RenderThread() {
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        _done.wait(guard, [this] { return !_pending; });
+        _stop = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+
+    _window.set_context_current(true);
+}
+
+void RenderThread::submit(const UNIFIED_GRAPHICS_NAMESPACE::CommandList *commands) {
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        _done.wait(guard, [this] { return !_pending; });
+        rethrow(guard);
+        _pending = commands;
+    }
+    _wake.notify_one();
+}
+
+void RenderThread::wait() {
+    std::unique_lock<std::mutex> guard(_lock);
+    _done.wait(guard, [this] { return !_pending; });
+    rethrow(guard);
+}
+
+void RenderThread::rethrow(std::unique_lock<std::mutex> &guard) {
+    if (!_error)
+        return;
+
+    std::exception_ptr error = nullptr;
+    std::swap(error, _error);
+    guard.unlock();
+    std::rethrow_exception(error);
+}
+
+void RenderThread::loop() {
+    _window.set_context_current(true);
+
+    for (;;) {
+        const UNIFIED_GRAPHICS_NAMESPACE::CommandList *commands;
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _wake.wait(guard, [this] { return _stop || _pending; });
+            if (_stop)
+                break;
+            commands = _pending;
+        }
+
+        // an exception must not end the thread, the main thread gets it with the next submit()
+        std::exception_ptr error = nullptr;
+        try {
+            commands->execute(_target);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _pending = nullptr;
+            if (error && !_error)
+                _error = std::move(error);
+        }
+        _done.notify_all();
+    }
+
+    _window.set_context_current(false);
+}
+
+UNIFIED_END_NAMESPACE
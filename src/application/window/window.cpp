@@ -1,6 +1,7 @@
 #include <unified/application/window/window.hpp>
 
 #include <unified/core/exceptions.hpp>
+#include <unified/graphics/context_owner.hpp>
 #include <GLFW/glfw3.h>
 
 UNIFIED_BEGIN_NAMESPACE
@@ -9,7 +10,34 @@ struct Window::glfw_wrapper {
     GLFWwindow *glfw_handle;
 };
 
-Window::Window(string title, VideoMode video_mode, u32 style) : _title(title), _window(new glfw_wrapper), _video_mode(video_mode), _vsync(false) {
+namespace {
+
+    EventQueue &queue_of(GLFWwindow *window) {
+        return *reinterpret_cast<EventQueue*>(glfwGetWindowUserPointer(window));
+    }
+
+    EventQueue::Entry make_entry(Event::Type type, double x = 0.0, double y = 0.0, int code = 0, int action = 0) {
+        EventQueue::Entry entry;
+        entry.type = type;
+        entry.timestamp = get_timestamp();
+        entry.coalesced = 0;
+        entry.x = x, entry.y = y;
+        entry.code = code, entry.action = action;
+        return entry;
+    }
+
+    template <class _event>
+    void dispatch_event(const Window::event_callback_fn &callback, _event &&event, Timestamp timestamp) {
+        event.timestamp = timestamp;
+        EventDispatcher dispatcher(event);
+        if (callback)
+            callback(dispatcher);
+    }
+
+}
+
+Window::Window(string title, VideoMode video_mode, u32 style) : _title(title), _window(new glfw_wrapper), _events(), _recorder(nullptr), _player(nullptr), _video_mode(video_mode), _vsync(false),
+      _deferred_swap(false), _swap_requested(false) {
     if (!glfwInit())
         throw Exceptions::initialization_failed("failed to initialize glfw");
 
@@ -22,61 +50,41 @@ Window::Window(string title, VideoMode video_mode, u32 style) : _title(title), _
 
     set_vsync(_vsync);
 
-    glfwSetWindowUserPointer(_window->glfw_handle, &_event_callback);
+    glfwSetWindowUserPointer(_window->glfw_handle, &_events);
     glfwSetWindowCloseCallback(_window->glfw_handle, [](GLFWwindow *window) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        WindowCloseEvent window_close;
-        EventDispatcher event(window_close);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::WindowClose));
     });
 
     glfwSetWindowPosCallback(_window->glfw_handle, [](GLFWwindow *window, int x, int y) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        WindowMoveEvent window_move_event(x, y);
-        EventDispatcher event(window_move_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::WindowMove, x, y));
     });
 
     glfwSetWindowFocusCallback(_window->glfw_handle, [](GLFWwindow *window, int focused) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        WindowFocusEvent window_focus_event(focused);
-        EventDispatcher event(window_focus_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::WindowFocus, 0.0, 0.0, focused));
     });
 
     glfwSetWindowSizeCallback(_window->glfw_handle, [](GLFWwindow *window, int horizontal, int vertical) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        WindowResizeEvent window_resize_event(horizontal, vertical);
-        EventDispatcher event(window_resize_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::WindowResize, horizontal, vertical));
     });
 
     glfwSetKeyCallback(_window->glfw_handle, [](GLFWwindow *window, int key, int, int action, int) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        KeyPressEvent key_press_event(key, action);
-        EventDispatcher event(key_press_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::KeyPress, 0.0, 0.0, key, action));
     });
 
     glfwSetCursorPosCallback(_window->glfw_handle, [](GLFWwindow *window, double x, double y) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        CursorMoveEvent cursor_move_event(x, y);
-        EventDispatcher event(cursor_move_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::CursorMove, x, y));
     });
 
     glfwSetMouseButtonCallback(_window->glfw_handle, [](GLFWwindow *window, int button, int action, int) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        MousePressEvent mouse_press_event(button, action);
-        EventDispatcher event(mouse_press_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::MousePress, 0.0, 0.0, button, action));
+    });
+
+    glfwSetScrollCallback(_window->glfw_handle, [](GLFWwindow *window, double x, double y) -> void {
+        queue_of(window).push(make_entry(Event::Type::MouseScroll, x, y));
     });
 
     glfwSetWindowMaximizeCallback(_window->glfw_handle, [](GLFWwindow *window, int maximized) -> void {
-        event_callback_fn &dispatch_function = *reinterpret_cast<event_callback_fn*>(glfwGetWindowUserPointer(window));
-        WindowMaximizeEvent window_maximize_event(maximized);
-        EventDispatcher event(window_maximize_event);
-        dispatch_function(event);
+        queue_of(window).push(make_entry(Event::Type::WindowMaximize, 0.0, 0.0, maximized));
     });
 }
 
@@ -86,9 +94,94 @@ Window::~Window() {
 
 bool Window::poll_events() const {
     glfwPollEvents();
+    dispatch_events();
     return !glfwWindowShouldClose(_window->glfw_handle);
 }
 
+bool Window::wait_events(Time timeout) const {
+    if (timeout > Time())
+        glfwWaitEventsTimeout(timeout.asSeconds());
+    else
+        glfwWaitEvents();
+    dispatch_events();
+    return !glfwWindowShouldClose(_window->glfw_handle);
+}
+
+void Window::post_empty_event() const {
+    glfwPostEmptyEvent();
+}
+
+UNIFIED_NODISCARD const EventQueue &Window::get_event_queue() const {
+    return _events;
+}
+
+void Window::set_event_recorder(EventRecorder *recorder) {
+    _recorder = recorder;
+}
+
+void Window::set_event_player(EventPlayer *player) {
+    _player = player;
+}
+
+void Window::dispatch_events() const {
+    _events.flush();
+
+    EventQueue::Entry entry;
+
+    if (_player) {
+        // live input is discarded while replaying
+        do {
+            while (_events.pop(entry)) { }
+        } while (_events.flush());
+        while (_player->next(entry))
+            dispatch_entry(entry);
+    } else {
+        // the ring refills from the overflow until both are empty
+        do {
+            while (_events.pop(entry)) {
+                if (_recorder)
+                    _recorder->record(entry);
+                dispatch_entry(entry);
+            }
+        } while (_events.flush());
+    }
+
+    if (_drain_callback)
+        _drain_callback();
+}
+
+void Window::dispatch_entry(const EventQueue::Entry &entry) const {
+    switch (entry.type) {
+        case Event::Type::WindowMaximize:
+            dispatch_event(_event_callback, WindowMaximizeEvent(entry.code), entry.timestamp);
+            break;
+        case Event::Type::WindowResize:
+            dispatch_event(_event_callback, WindowResizeEvent(int(entry.x), int(entry.y)), entry.timestamp);
+            break;
+        case Event::Type::WindowFocus:
+            dispatch_event(_event_callback, WindowFocusEvent(entry.code), entry.timestamp);
+            break;
+        case Event::Type::WindowClose:
+            dispatch_event(_event_callback, WindowCloseEvent(), entry.timestamp);
+            break;
+        case Event::Type::WindowMove:
+            dispatch_event(_event_callback, WindowMoveEvent(int(entry.x), int(entry.y)), entry.timestamp);
+            break;
+        case Event::Type::CursorMove:
+            dispatch_event(_event_callback, CursorMoveEvent(entry.x, entry.y), entry.timestamp);
+            break;
+        case Event::Type::MousePress:
+            dispatch_event(_event_callback, MousePressEvent(entry.code, entry.action), entry.timestamp);
+            break;
+        case Event::Type::MouseScroll:
+            dispatch_event(_event_callback, MouseScrollEvent(entry.x, entry.y), entry.timestamp);
+            break;
+        case Event::Type::KeyPress:
+            dispatch_event(_event_callback, KeyPressEvent(entry.code, entry.action), entry.timestamp);
+            break;
+    }
+}
+
 void Window::set_title(string title) {
     glfwSetWindowTitle(_window->glfw_handle, (_title = title).c_str());
 }
@@ -129,9 +222,36 @@ void *Window::get_native_window() const {
 }
 
 void Window::swap_buffers() const {
+    if (_deferred_swap)
+        _swap_requested = true;
+    else
+        glfwSwapBuffers(_window->glfw_handle);
+}
+
+void Window::set_deferred_swap(bool deferred) {
+    _deferred_swap = deferred;
+    _swap_requested = false;
+}
+
+bool Window::take_swap_request() const {
+    bool requested = _swap_requested;
+    _swap_requested = false;
+    return requested;
+}
+
+void Window::present() const {
     glfwSwapBuffers(_window->glfw_handle);
 }
 
+void Window::set_context_current(bool current) const {
+    glfwMakeContextCurrent(current ? _window->glfw_handle : nullptr);
+
+    if (current)
+        UNIFIED_GRAPHICS_NAMESPACE::ContextOwner::acquire();
+    else
+        UNIFIED_GRAPHICS_NAMESPACE::ContextOwner::release();
+}
+
 Keyboard::Action Window::get_key_action(Keyboard::Code code) const {
     return (Keyboard::Action)glfwGetKey(_window->glfw_handle, (int)code);
 }
@@ -146,4 +266,8 @@ void Window::set_event_callback(const event_callback_fn &callback) {
     _event_callback = callback;
 }
 
+void Window::set_drain_callback(const drain_callback_fn &callback) {
+    _drain_callback = callback;
+}
+
 UNIFIED_END_NAMESPACE
@@ -0,0 +1,267 @@
+#include <unified/core/log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+UNIFIED_BEGIN_NAMESPACE
+
+namespace
+{
+    struct alignas(16) Record
+    {
+        Logger::Level level;
+        u32 size;
+        u32 text_size;
+        const char *text;
+        Timestamp timestamp;
+        void (*format)(fmt::memory_buffer &out, std::string_view format, u8 *payload);
+    };
+
+    UNIFIED_CONSTEXPR u32 align(u32 size) {
+        return (size + 15) & ~15u;
+    }
+
+    // records are whole granules, so whatever is left before the end of the ring can take a padding record
+    UNIFIED_CONSTEXPR u32 granule_size = 64;
+    static_assert(sizeof(Record) <= granule_size, "log record header outgrew its granule");
+
+    UNIFIED_CONSTEXPR u32 granules(u32 size) {
+        return (size + granule_size - 1) & ~(granule_size - 1);
+    }
+
+    struct Ring
+    {
+        alignas(16) u8 data[Logger::ring_size];
+
+        // head is only written by the owning thread, tail only by the writer
+        std::atomic<u64> head { 0 };
+        std::atomic<u64> tail { 0 };
+        std::atomic<bool> abandoned { false };
+
+        u64 reserved = 0;
+    };
+
+    struct RingOwner
+    {
+        Ring *ring = nullptr;
+
+        ~RingOwner() {
+            if (ring)
+                ring->abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    const char *level_name(Logger::Level level) {
+        static const char *names[] = { "trace", "debug", "info", "warning", "error", "critical" };
+        return names[static_cast<u32>(level) % 6];
+    }
+
+    class Writer
+    {
+    public:
+
+        Writer() : _start(get_timestamp()), _sink(stdout), _level(Logger::Level::Trace), _dropped(0), _running(true), _pass(0) {
+            _thread = std::thread(&Writer::loop, this);
+        }
+
+        ~Writer() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _running = false;
+            }
+            _wake.notify_one();
+            _thread.join();
+
+            for (Ring *ring : _rings)
+                delete ring;
+        }
+
+        Ring *add_ring() {
+            Ring *ring = new Ring();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _rings.push_back(ring);
+            return ring;
+        }
+
+        void wake() {
+            _wake.notify_one();
+        }
+
+        void flush() {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            // a pass holds the mutex until it is done, so the next one starts after everything logged so far
+            const u64 target = _pass + 1;
+            _wake.notify_one();
+            _flushed.wait(lock, [&]() { return _pass >= target || !_running; });
+        }
+
+        Timestamp _start;
+
+        std::atomic<std::FILE*> _sink;
+        std::atomic<Logger::Level> _level;
+        std::atomic<u64> _dropped;
+
+    protected:
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            for (;;) {
+                const bool running = _running;
+
+                drain();
+                ++_pass;
+                _flushed.notify_all();
+
+                if (!running)
+                    break;
+
+                _wake.wait_for(lock, std::chrono::milliseconds(5));
+            }
+        }
+
+        void drain() {
+            for (auto it = _rings.begin(); it != _rings.end();) {
+                Ring *ring = *it;
+
+                // read first, whatever the thread wrote before leaving is still drained below
+                const bool abandoned = ring->abandoned.load(std::memory_order_acquire);
+
+                const u64 head = ring->head.load(std::memory_order_acquire);
+                u64 tail = ring->tail.load(std::memory_order_relaxed);
+
+                while (tail != head) {
+                    Record *record = reinterpret_cast<Record*>(ring->data + (tail & (Logger::ring_size - 1)));
+                    if (record->format)
+                        format(*record);
+                    tail += record->size;
+                }
+                ring->tail.store(tail, std::memory_order_release);
+
+                if (abandoned) {
+                    delete ring;
+                    it = _rings.erase(it);
+                } else
+                    ++it;
+            }
+
+            if (_buffer.size()) {
+                std::FILE *sink = _sink.load(std::memory_order_relaxed);
+                std::fwrite(_buffer.data(), 1, _buffer.size(), sink);
+                std::fflush(sink);
+                _buffer.clear();
+            }
+        }
+
+        void format(Record &record) {
+            const double time = timestamp_to_time(record.timestamp - _start).asSeconds();
+            fmt::format_to(std::back_inserter(_buffer), "[{:.6f}] [{}] ", time, level_name(record.level));
+
+            u8 *payload = reinterpret_cast<u8*>(&record) + align(sizeof(Record));
+            try {
+                record.format(_buffer, std::string_view(record.text, record.text_size), payload);
+            } catch (const fmt::format_error &error) {
+                fmt::format_to(std::back_inserter(_buffer), "<format error: {}>", error.what());
+            }
+
+            _buffer.push_back('\n');
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _flushed;
+
+        std::vector<Ring*> _rings;
+        fmt::memory_buffer _buffer;
+
+        bool _running;
+        u64 _pass;
+
+        std::thread _thread;
+
+    };
+
+    Writer &get_writer() {
+        static Writer writer;
+        return writer;
+    }
+
+    thread_local RingOwner local_ring;
+
+    Ring *get_ring() {
+        if (!local_ring.ring)
+            local_ring.ring = get_writer().add_ring();
+        return local_ring.ring;
+    }
+}
+
+void Logger::set_sink(std::FILE *sink) {
+    flush();
+    get_writer()._sink.store(sink ? sink : stdout, std::memory_order_relaxed);
+}
+
+void Logger::set_level(Level level) {
+    get_writer()._level.store(level, std::memory_order_relaxed);
+}
+
+UNIFIED_NODISCARD Logger::Level Logger::get_level() {
+    return get_writer()._level.load(std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    get_writer().flush();
+}
+
+UNIFIED_NODISCARD u64 Logger::get_dropped_count() {
+    return get_writer()._dropped.load(std::memory_order_relaxed);
+}
+
+u8 *Logger::reserve(Level level, u32 size, format_fn format, std::string_view text) {
+    Ring *ring = get_ring();
+
+    // the format text goes after the payload, a runtime format string may not outlive the call
+    const u32 total = granules(align(sizeof(Record)) + size + static_cast<u32>(text.size()));
+    const u64 head = ring->head.load(std::memory_order_relaxed);
+    const u64 used = head - ring->tail.load(std::memory_order_acquire);
+
+    // a record never wraps, the end of the ring is skipped with a padding record instead
+    const u32 offset = static_cast<u32>(head & (ring_size - 1));
+    const u32 padding = ring_size - offset < total ? ring_size - offset : 0;
+
+    if (total > ring_size / 2 || used + padding + total > ring_size) {
+        get_writer()._dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // the writer polls, a ring filling up faster than that gets it going early
+    if (used <= ring_size / 2 && used + padding + total > ring_size / 2)
+        get_writer().wake();
+
+    if (padding) {
+        new (ring->data + offset) Record { level, padding, 0, nullptr, 0, nullptr };
+        ring->head.store(head + padding, std::memory_order_release);
+    }
+
+    u8 *payload = ring->data + (offset + padding) % ring_size + align(sizeof(Record));
+    std::memcpy(payload + size, text.data(), text.size());
+
+    new (payload - align(sizeof(Record))) Record {
+        level, total, static_cast<u32>(text.size()), reinterpret_cast<const char*>(payload + size), get_timestamp(), format
+    };
+
+    ring->reserved = total;
+    return payload;
+}
+
+void Logger::commit() {
+    Ring *ring = local_ring.ring;
+    ring->head.store(ring->head.load(std::memory_order_relaxed) + ring->reserved, std::memory_order_release);
+}
+
+UNIFIED_END_NAMESPACE
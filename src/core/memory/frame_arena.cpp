@@ -0,0 +1,109 @@
+#include <unified/core/memory/frame_arena.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <algorithm>
+#include <new>
+
+UNIFIED_BEGIN_NAMESPACE
+
+std::atomic<u64> FrameArena::_current_frame(0);
+
+FrameArena::FrameArena(u64 block_size)
+    : _blocks(), _block_size(block_size), _offset(0), _retired(0), _frame(_current_frame.load(std::memory_order_relaxed)) {
+    if (!block_size)
+        throw Exceptions::misbehavior("bad frame arena block size");
+}
+
+FrameArena::~FrameArena() {
+    for (Block &block : _blocks)
+        ::operator delete(block.data);
+}
+
+void *FrameArena::allocate(u64 size, u64 alignment) {
+    if (!size)
+        size = 1;
+
+    if (!_blocks.empty()) {
+        const Block &block = _blocks.back();
+        const u64 offset = (reinterpret_cast<u64>(block.data + _offset) + alignment - 1) & ~(alignment - 1);
+        const u64 start = offset - reinterpret_cast<u64>(block.data);
+
+        if (start + size <= block.size) {
+            _offset = start + size;
+            return block.data + start;
+        }
+    }
+
+    grow(size + alignment);
+
+    const Block &block = _blocks.back();
+    const u64 start = ((reinterpret_cast<u64>(block.data) + alignment - 1) & ~(alignment - 1)) - reinterpret_cast<u64>(block.data);
+
+    _offset = start + size;
+    return block.data + start;
+}
+
+void FrameArena::deallocate(void *pointer, u64 size) {
+    if (_blocks.empty() || !pointer)
+        return;
+
+    u8 *data = static_cast<u8*>(pointer);
+    const Block &block = _blocks.back();
+
+    if (data >= block.data && data + std::max<u64>(size, 1) == block.data + _offset)
+        _offset = static_cast<u64>(data - block.data);
+}
+
+void FrameArena::reset() {
+    if (_blocks.size() > 1) {
+        u64 capacity = 0;
+        for (Block &block : _blocks) {
+            capacity += block.size;
+            ::operator delete(block.data);
+        }
+
+        _blocks.clear();
+        _blocks.push_back(Block { static_cast<u8*>(::operator new(capacity)), capacity });
+    }
+
+    _offset = 0;
+    _retired = 0;
+}
+
+UNIFIED_NODISCARD u64 FrameArena::get_used() const {
+    return _retired + _offset;
+}
+
+UNIFIED_NODISCARD u64 FrameArena::get_capacity() const {
+    u64 capacity = 0;
+    for (const Block &block : _blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+FrameArena &FrameArena::local() {
+    thread_local FrameArena arena;
+
+    const u64 frame = _current_frame.load(std::memory_order_relaxed);
+    if (arena._frame != frame) {
+        arena.reset();
+        arena._frame = frame;
+    }
+
+    return arena;
+}
+
+void FrameArena::next_frame() {
+    _current_frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameArena::grow(u64 size) {
+    if (!_blocks.empty())
+        _retired += _offset;
+
+    const u64 capacity = std::max(size, _block_size);
+    _blocks.push_back(Block { static_cast<u8*>(::operator new(capacity)), capacity });
+    _offset = 0;
+}
+
+UNIFIED_END_NAMESPACE
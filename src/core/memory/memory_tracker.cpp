@@ -0,0 +1,210 @@
+#include <unified/core/memory/memory_tracker.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+UNIFIED_BEGIN_NAMESPACE
+
+MemoryTracker::TagCounters MemoryTracker::_counters[MemoryTracker::tag_count];
+
+std::atomic<bool> MemoryTracker::_guard_enabled(false);
+std::atomic<bool> MemoryTracker::_guard_armed(false);
+std::atomic<u32> MemoryTracker::_guard_warmup(0);
+
+thread_local MemoryTag MemoryTracker::_current_tag = MemoryTag::General;
+thread_local u32 MemoryTracker::_allowed = 0;
+
+UNIFIED_NODISCARD bool MemoryTracker::is_tracking() {
+#ifdef UNIFIED_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+UNIFIED_NODISCARD MemoryTracker::Counters MemoryTracker::get_counters(MemoryTag tag) {
+    const TagCounters &counters = _counters[static_cast<u32>(tag) % tag_count];
+
+    return Counters {
+        counters.bytes.load(std::memory_order_relaxed),
+        counters.allocations.load(std::memory_order_relaxed),
+        counters.frees.load(std::memory_order_relaxed),
+        counters.last_frame_bytes.load(std::memory_order_relaxed),
+        counters.last_frame_allocations.load(std::memory_order_relaxed),
+        static_cast<u64>(std::max<s64>(counters.gpu_bytes.load(std::memory_order_relaxed), 0))
+    };
+}
+
+UNIFIED_NODISCARD u64 MemoryTracker::get_frame_allocations() {
+    u64 allocations = 0;
+    for (const TagCounters &counters : _counters)
+        allocations += counters.last_frame_allocations.load(std::memory_order_relaxed);
+    return allocations;
+}
+
+UNIFIED_NODISCARD const char *MemoryTracker::get_tag_name(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::General:  return "general";
+        case MemoryTag::Textures: return "textures";
+        case MemoryTag::Buffers:  return "buffers";
+        case MemoryTag::Layers:   return "layers";
+        case MemoryTag::Modules:  return "modules";
+        default: return "unknown";
+    }
+}
+
+UNIFIED_NODISCARD MemoryTag MemoryTracker::get_current_tag() {
+    return _current_tag;
+}
+
+void MemoryTracker::record_allocation(MemoryTag tag, u64 size) {
+    // disarmed first so the report itself may allocate
+    if (_guard_armed.load(std::memory_order_relaxed) && !_allowed) {
+        _guard_armed.store(false, std::memory_order_relaxed);
+        std::fprintf(stderr, "heap allocation of %llu bytes (%s) in a steady state frame\n", size, get_tag_name(tag));
+        std::abort();
+    }
+
+    TagCounters &counters = _counters[static_cast<u32>(tag) % tag_count];
+
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.frame_bytes.fetch_add(size, std::memory_order_relaxed);
+    counters.frame_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::record_free(MemoryTag tag, u64 size) {
+    TagCounters &counters = _counters[static_cast<u32>(tag) % tag_count];
+
+    counters.bytes.fetch_sub(size, std::memory_order_relaxed);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::record_gpu(MemoryTag tag, s64 delta) {
+    _counters[static_cast<u32>(tag) % tag_count].gpu_bytes.fetch_add(delta, std::memory_order_relaxed);
+}
+
+void MemoryTracker::set_frame_guard(bool enabled, u32 warmup_frames) {
+    _guard_armed.store(false, std::memory_order_relaxed);
+    _guard_warmup.store(warmup_frames, std::memory_order_relaxed);
+    _guard_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+UNIFIED_NODISCARD bool MemoryTracker::get_frame_guard() {
+    return _guard_enabled.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::next_frame() {
+    for (TagCounters &counters : _counters) {
+        counters.last_frame_bytes.store(counters.frame_bytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        counters.last_frame_allocations.store(counters.frame_allocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    if (!_guard_enabled.load(std::memory_order_relaxed) || _guard_armed.load(std::memory_order_relaxed))
+        return;
+
+    const u32 warmup = _guard_warmup.load(std::memory_order_relaxed);
+    if (warmup)
+        _guard_warmup.store(warmup - 1, std::memory_order_relaxed);
+    else
+        _guard_armed.store(true, std::memory_order_relaxed);
+}
+
+MemoryTracker::ScopeTag::ScopeTag(MemoryTag tag) : _prev(_current_tag) {
+    _current_tag = tag;
+}
+
+MemoryTracker::ScopeTag::~ScopeTag() {
+    _current_tag = _prev;
+}
+
+MemoryTracker::ScopeAllow::ScopeAllow() {
+    ++_allowed;
+}
+
+MemoryTracker::ScopeAllow::~ScopeAllow() {
+    --_allowed;
+}
+
+UNIFIED_END_NAMESPACE
+
+#ifdef UNIFIED_TRACK_ALLOCATIONS
+
+namespace
+{
+    using UNIFIED_NAMESPACE::u8;
+    using UNIFIED_NAMESPACE::u32;
+    using UNIFIED_NAMESPACE::u64;
+    using UNIFIED_NAMESPACE::MemoryTag;
+    using UNIFIED_NAMESPACE::MemoryTracker;
+
+    // sits right in front of every block, the size and tag are needed again when it is freed
+    struct alignas(16) Header
+    {
+        u64 size;
+        u32 offset;
+        MemoryTag tag;
+    };
+
+    void *tracked_allocate(std::size_t size, std::size_t alignment, bool nothrow) {
+        if (alignment < alignof(Header))
+            alignment = alignof(Header);
+
+        const MemoryTag tag = MemoryTracker::get_current_tag();
+        MemoryTracker::record_allocation(tag, size);
+
+        u8 *raw = static_cast<u8*>(std::malloc(size + alignment + sizeof(Header)));
+        if (!raw) {
+            MemoryTracker::record_free(tag, size);
+            if (nothrow)
+                return nullptr;
+            throw std::bad_alloc();
+        }
+
+        const u64 address = (reinterpret_cast<u64>(raw) + sizeof(Header) + alignment - 1) & ~static_cast<u64>(alignment - 1);
+        u8 *data = reinterpret_cast<u8*>(address);
+
+        Header *header = reinterpret_cast<Header*>(data) - 1;
+        header->size = size;
+        header->offset = static_cast<u32>(data - raw);
+        header->tag = tag;
+
+        return data;
+    }
+
+    void tracked_free(void *pointer) noexcept {
+        if (!pointer)
+            return;
+
+        Header *header = static_cast<Header*>(pointer) - 1;
+        MemoryTracker::record_free(header->tag, header->size);
+
+        std::free(static_cast<u8*>(pointer) - header->offset);
+    }
+}
+
+void *operator new(std::size_t size) { return tracked_allocate(size, 0, false); }
+void *operator new[](std::size_t size) { return tracked_allocate(size, 0, false); }
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked_allocate(size, 0, true); }
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked_allocate(size, 0, true); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return tracked_allocate(size, static_cast<std::size_t>(alignment), false); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return tracked_allocate(size, static_cast<std::size_t>(alignment), false); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return tracked_allocate(size, static_cast<std::size_t>(alignment), true); }
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return tracked_allocate(size, static_cast<std::size_t>(alignment), true); }
+
+void operator delete(void *pointer) noexcept { tracked_free(pointer); }
+void operator delete[](void *pointer) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { tracked_free(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, const std::nothrow_t&) noexcept { tracked_free(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t&) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { tracked_free(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { tracked_free(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { tracked_free(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t&) noexcept { tracked_free(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t&) noexcept { tracked_free(pointer); }
+
+#endif
@@ -0,0 +1,136 @@
+#include <unified/core/system/frame_pacer.hpp>
+#include <unified/platform/platform.hpp>
+
+#if defined(UNIFIED_PLATFORM_WINDOWS)
+
+# include <windows.h>
+
+# if !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#  define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+# endif
+
+namespace
+{
+    // a high resolution waitable timer wakes within a fraction of a millisecond without raising the
+    // system wide timer resolution. systems that reject the flag get a plain timer, which like Sleep()
+    // is only accurate to the scheduler tick, so the rest of the frame is spun over a wider margin
+    struct WaitableTimer
+    {
+        HANDLE handle;
+        bool high_resolution;
+
+        WaitableTimer() : handle(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS)), high_resolution(handle != nullptr) {
+            if (!handle)
+                handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+
+        ~WaitableTimer() {
+            if (handle)
+                CloseHandle(handle);
+        }
+    };
+
+    WaitableTimer &get_timer() {
+        static thread_local WaitableTimer timer;
+        return timer;
+    }
+
+    UNIFIED_NAMESPACE::Time spin_margin() {
+        return get_timer().high_resolution ? UNIFIED_NAMESPACE::microseconds(500) : UNIFIED_NAMESPACE::milliseconds(2);
+    }
+
+    void sleep_until(UNIFIED_NAMESPACE::Time deadline) {
+        auto remaining = deadline - UNIFIED_NAMESPACE::get_current_time();
+        if (remaining <= UNIFIED_NAMESPACE::Time())
+            return;
+
+        // a negative due time is relative, in 100 ns units
+        LARGE_INTEGER due;
+        due.QuadPart = -static_cast<LONGLONG>(remaining.asNanoseconds() / 100);
+
+        WaitableTimer &timer = get_timer();
+        if (timer.handle && SetWaitableTimer(timer.handle, &due, 0, nullptr, nullptr, FALSE))
+            WaitForSingleObject(timer.handle, INFINITE);
+        else
+            ::Sleep(remaining.asMilliseconds());
+    }
+
+    void spin_pause() {
+        YieldProcessor();
+    }
+}
+
+#elif defined(UNIFIED_PLATFORM_LINUX)
+
+# include <time.h>
+# include <errno.h>
+
+namespace
+{
+    UNIFIED_CONSTEXPR UNIFIED_NAMESPACE::Time spin_margin() {
+        return UNIFIED_NAMESPACE::microseconds(200);
+    }
+
+    void sleep_until(UNIFIED_NAMESPACE::Time deadline) {
+        timespec target;
+        target.tv_sec = static_cast<time_t>(deadline.asNanoseconds() / 1000000000LL);
+        target.tv_nsec = static_cast<long>(deadline.asNanoseconds() % 1000000000LL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, 0) == EINTR) { }
+    }
+
+    void spin_pause() {
+# if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+# endif
+    }
+}
+
+#endif
+
+UNIFIED_BEGIN_NAMESPACE
+
+FramePacer::FramePacer() : _period(), _deadline(), _missed_deadlines(0) { }
+
+UNIFIED_NODISCARD Time FramePacer::get_period() const {
+    return _period;
+}
+
+void FramePacer::set_period(Time period) {
+    _period = period;
+    reset();
+}
+
+void FramePacer::reset() {
+    _deadline = get_current_time() + _period;
+}
+
+Time FramePacer::wait() {
+    if (_period == Time())
+        return Time();
+
+    Time now = get_current_time();
+
+    if (now < _deadline) {
+        const Time margin = spin_margin();
+        if (_deadline - now > margin)
+            sleep_until(_deadline - margin);
+        while ((now = get_current_time()) < _deadline)
+            spin_pause();
+    } else {
+        ++_missed_deadlines;
+    }
+
+    Time lateness = now - _deadline;
+
+    // the timeline advances by whole periods so sleep errors do not accumulate,
+    // a frame that overran a full period restarts it instead of trying to catch up
+    _deadline = (lateness >= _period ? now : _deadline) + _period;
+
+    return lateness;
+}
+
+UNIFIED_NODISCARD u64 FramePacer::get_missed_deadlines() const {
+    return _missed_deadlines;
+}
+
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,331 @@
+#include <unified/core/system/job_system.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+namespace {
+
+    using UNIFIED_NAMESPACE::u32;
+
+    // the system the calling thread works for and the queue it owns there
+    thread_local const void *current_system = nullptr;
+    thread_local u32 current_index = 0;
+
+}
+
+JobSystem::JobSystem(u32 workers) : _main_thread(std::this_thread::get_id()), _free_jobs(nullptr), _queued(0), _stop(false) {
+    if (!workers) {
+        const u32 hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    _queues = std::vector<Queue>(workers + 1);
+
+    // the first block of jobs up front
+    free_job(allocate_job());
+
+    current_system = this;
+    current_index = 0;
+
+    _workers.reserve(workers);
+    for (u32 i = 1; i <= workers; ++i)
+        _workers.emplace_back(&JobSystem::worker_loop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> guard(_sleep_lock);
+        _stop.store(true);
+    }
+    _sleep.notify_all();
+
+    for (std::thread &worker : _workers)
+        worker.join();
+
+    // whatever never ran is only released
+    for (Queue &queue : _queues)
+        while (Job *job = queue.pop_front())
+            job->invoke(*job, false);
+    while (Job *job = _main_queue.pop_front())
+        job->invoke(*job, false);
+
+    if (current_system == this)
+        current_system = nullptr;
+}
+
+void JobSystem::wait(Counter &counter) {
+    const u32 index = current_queue();
+    const bool main_thread = is_main_thread();
+
+    while (!counter.done()) {
+        Job *job = main_thread ? nullptr : acquire(index);
+
+        if (main_thread) {
+            {
+                std::lock_guard<std::mutex> guard(_main_queue.lock);
+                job = _main_queue.pop_front();
+            }
+            if (!job)
+                job = acquire(index);
+        }
+
+        if (job)
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+
+    // the last job may still be inside execute() holding the lock, the counter must outlive it
+    std::exception_ptr error = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(counter._lock);
+        std::swap(error, counter._error);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void JobSystem::process_main_thread_jobs() {
+    {
+        std::exception_ptr error = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(_error_lock);
+            std::swap(error, _error);
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // jobs queued by the ones run here wait for the next call
+    u32 count;
+    {
+        std::lock_guard<std::mutex> guard(_main_queue.lock);
+        count = _main_queue.count;
+    }
+
+    for (; count; --count) {
+        Job *job;
+        {
+            std::lock_guard<std::mutex> guard(_main_queue.lock);
+            job = _main_queue.pop_front();
+        }
+        if (!job)
+            break;
+        execute(job);
+    }
+}
+
+UNIFIED_NODISCARD u32 JobSystem::get_worker_count() const {
+    return static_cast<u32>(_workers.size());
+}
+
+UNIFIED_NODISCARD bool JobSystem::is_main_thread() const {
+    return std::this_thread::get_id() == _main_thread;
+}
+
+UNIFIED_NODISCARD u32 JobSystem::get_thread_index() const {
+    return current_queue();
+}
+
+void JobSystem::submit(Job *job, Counter *dependency) {
+    if (job->counter)
+        job->counter->_value.fetch_add(1, std::memory_order_relaxed);
+
+    if (dependency) {
+        std::lock_guard<std::mutex> guard(dependency->_lock);
+        if (!dependency->done()) {
+            job->next = dependency->_waiters;
+            dependency->_waiters = job;
+            return;
+        }
+    }
+
+    enqueue(job);
+}
+
+void JobSystem::enqueue(Job *job) {
+    if (job->affinity == Affinity::MainThread) {
+        // nothing else may run these, so this one queue grows instead
+        std::lock_guard<std::mutex> guard(_main_queue.lock);
+        if (!_main_queue.push_back(job)) {
+            _main_queue.grow();
+            _main_queue.push_back(job);
+        }
+        return;
+    }
+
+    Queue &queue = _queues[current_queue()];
+    bool queued;
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queued = queue.push_back(job);
+    }
+
+    if (!queued) {
+        execute(job);
+        return;
+    }
+
+    _queued.fetch_add(1, std::memory_order_release);
+    {
+        // taking the lock orders the increment against a worker that is about to sleep
+        std::lock_guard<std::mutex> guard(_sleep_lock);
+    }
+    _sleep.notify_one();
+}
+
+void JobSystem::execute(Job *job) {
+    // a throwing job still finishes, otherwise its counter never drops and the waiters hang
+    std::exception_ptr error = nullptr;
+    try {
+        job->invoke(*job, true);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    Counter *counter = job->counter;
+    free_job(job);
+
+    if (!counter) {
+        if (error) {
+            std::lock_guard<std::mutex> guard(_error_lock);
+            if (!_error)
+                _error = std::move(error);
+        }
+        return;
+    }
+
+    Job *waiters;
+    {
+        std::lock_guard<std::mutex> guard(counter->_lock);
+        if (error && !counter->_error)
+            counter->_error = std::move(error);
+        if (counter->_value.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        waiters = counter->_waiters;
+        counter->_waiters = nullptr;
+    }
+
+    while (waiters) {
+        Job *waiter = waiters;
+        waiters = waiter->next;
+        enqueue(waiter);
+    }
+}
+
+JobSystem::Job *JobSystem::allocate_job() {
+    std::lock_guard<std::mutex> guard(_pool_lock);
+
+    if (!_free_jobs) {
+        _job_blocks.emplace_back(new Job[job_block_size]);
+
+        Job *block = _job_blocks.back().get();
+        for (u32 i = 0; i < job_block_size; ++i)
+            block[i].next = i + 1 < job_block_size ? &block[i + 1] : nullptr;
+        _free_jobs = block;
+    }
+
+    Job *job = _free_jobs;
+    _free_jobs = job->next;
+    return job;
+}
+
+void JobSystem::free_job(Job *job) {
+    std::lock_guard<std::mutex> guard(_pool_lock);
+    job->next = _free_jobs;
+    _free_jobs = job;
+}
+
+bool JobSystem::Queue::push_back(Job *job) {
+    if (count == capacity)
+        return false;
+
+    jobs[(first + count++) & (capacity - 1)] = job;
+    return true;
+}
+
+JobSystem::Job *JobSystem::Queue::pop_back() {
+    return count ? jobs[(first + --count) & (capacity - 1)] : nullptr;
+}
+
+JobSystem::Job *JobSystem::Queue::pop_front() {
+    if (!count)
+        return nullptr;
+
+    Job *job = jobs[first];
+    first = (first + 1) & (capacity - 1);
+    --count;
+    return job;
+}
+
+void JobSystem::Queue::grow() {
+    std::unique_ptr<Job*[]> grown(new Job*[capacity * 2]);
+    for (u32 i = 0; i < count; ++i)
+        grown[i] = jobs[(first + i) & (capacity - 1)];
+
+    jobs = std::move(grown);
+    capacity *= 2;
+    first = 0;
+}
+
+JobSystem::Job *JobSystem::pop(u32 index) {
+    Queue &queue = _queues[index];
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    // the owner works from the back where the freshest, cache warm jobs are
+    Job *job = queue.pop_back();
+    if (job)
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+JobSystem::Job *JobSystem::steal(u32 index) {
+    const u32 count = static_cast<u32>(_queues.size());
+
+    for (u32 offset = 1; offset < count; ++offset) {
+        Queue &queue = _queues[(index + offset) % count];
+        std::lock_guard<std::mutex> guard(queue.lock);
+
+        Job *job = queue.pop_front();
+        if (!job)
+            continue;
+
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    return nullptr;
+}
+
+JobSystem::Job *JobSystem::acquire(u32 index) {
+    if (!_queued.load(std::memory_order_acquire))
+        return nullptr;
+
+    Job *job = pop(index);
+    return job ? job : steal(index);
+}
+
+void JobSystem::worker_loop(u32 index) {
+    current_system = this;
+    current_index = index;
+
+    for (;;) {
+        if (Job *job = acquire(index)) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(_sleep_lock);
+        _sleep.wait(guard, [this] { return _stop.load() || _queued.load(std::memory_order_acquire) != 0; });
+
+        if (_stop.load())
+            return;
+    }
+}
+
+UNIFIED_NODISCARD u32 JobSystem::current_queue() const {
+    // threads outside the system share the creator's queue, the workers steal from it anyway
+    return current_system == this ? current_index : 0;
+}
+
+UNIFIED_END_NAMESPACE
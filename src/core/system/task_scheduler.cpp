@@ -0,0 +1,147 @@
+#include <unified/core/system/task_scheduler.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <initializer_list>
+#include <algorithm>
+
+UNIFIED_BEGIN_NAMESPACE
+
+TaskScheduler::TaskScheduler() : _tasks(), _incoming(), _history(), _next_handle(1), _running(false) { }
+
+TaskScheduler::Handle TaskScheduler::submit(string name, task_fn task, Priority priority, Time deadline) {
+    if (!task)
+        throw Exceptions::misbehavior("bad task function");
+
+    const Handle handle = _next_handle++;
+    Stats stats { handle, name, priority, Time(), Time(), 0, 0, false, false };
+    Task entry { stats, std::move(task), deadline > Time() ? get_current_time() + deadline : Time(), false };
+
+    (_running ? _incoming : _tasks).push_back(std::move(entry));
+    return handle;
+}
+
+bool TaskScheduler::cancel(Handle handle) {
+    for (std::vector<Task> *tasks : { &_tasks, &_incoming })
+        for (Task &task : *tasks)
+            if (task.stats.handle == handle && !task.cancelled && !task.stats.finished) {
+                task.cancelled = true;
+                if (!_running)
+                    collect();
+                return true;
+            }
+    return false;
+}
+
+void TaskScheduler::run(Time budget) {
+    if (_tasks.empty())
+        return;
+
+    const Time start = get_current_time();
+    Time now = start;
+
+    auto overdue = [start](const Task &task) {
+        return task.deadline != Time() && task.deadline <= start;
+    };
+
+    // overdue tasks first, then by priority, then the closest deadline; submission order breaks ties
+    std::stable_sort(_tasks.begin(), _tasks.end(), [&overdue](const Task &left, const Task &right) {
+        if (overdue(left) != overdue(right))
+            return overdue(left);
+        if (left.stats.priority != right.stats.priority)
+            return left.stats.priority > right.stats.priority;
+        if ((left.deadline != Time()) != (right.deadline != Time()))
+            return left.deadline != Time();
+        return left.deadline < right.deadline;
+    });
+
+    // a task that throws must not leave submissions stuck in _incoming
+    struct ScopeRunning
+    {
+        explicit ScopeRunning(TaskScheduler &scheduler) : _scheduler(scheduler) { _scheduler._running = true; }
+        ~ScopeRunning() { _scheduler._running = false; _scheduler.collect(); }
+
+        TaskScheduler &_scheduler;
+    } running(*this);
+
+    for (Task &task : _tasks) {
+        ++task.stats.frames;
+        if (overdue(task) && !task.cancelled) {
+            task.stats.missed_deadline = true;
+            slice(task, now);
+        }
+    }
+
+    // round robin over the ordered tasks so a single long task cannot starve the rest
+    for (bool ran = true; ran && now - start < budget;) {
+        ran = false;
+        for (Task &task : _tasks) {
+            if (now - start >= budget)
+                break;
+            if (task.cancelled || task.stats.finished)
+                continue;
+            slice(task, now);
+            ran = true;
+        }
+    }
+}
+
+UNIFIED_NODISCARD bool TaskScheduler::is_pending(Handle handle) const {
+    for (const std::vector<Task> *tasks : { &_tasks, &_incoming })
+        for (const Task &task : *tasks)
+            if (task.stats.handle == handle)
+                return !task.cancelled && !task.stats.finished;
+    return false;
+}
+
+UNIFIED_NODISCARD u32 TaskScheduler::get_pending_count() const {
+    u32 count = 0;
+    for (const std::vector<Task> *tasks : { &_tasks, &_incoming })
+        for (const Task &task : *tasks)
+            count += !task.cancelled && !task.stats.finished;
+    return count;
+}
+
+UNIFIED_NODISCARD std::vector<TaskScheduler::Stats> TaskScheduler::get_stats() const {
+    std::vector<Stats> stats;
+    stats.reserve(_tasks.size() + _history.size());
+
+    for (const std::vector<Task> *tasks : { &_tasks, &_incoming })
+        for (const Task &task : *tasks)
+            if (!task.cancelled)
+                stats.push_back(task.stats);
+    stats.insert(stats.end(), _history.begin(), _history.end());
+    return stats;
+}
+
+void TaskScheduler::slice(Task &task, Time &now) {
+    const bool done = task.function();
+
+    const Time end = get_current_time();
+    const Time duration = end - now;
+    now = end;
+
+    task.stats.runtime += duration;
+    task.stats.longest_slice = std::max(task.stats.longest_slice, duration);
+    ++task.stats.slices;
+    task.stats.finished = done;
+}
+
+void TaskScheduler::collect() {
+    for (Task &task : _tasks)
+        if (task.stats.finished) {
+            _history.push_front(std::move(task.stats));
+            if (_history.size() > history_size)
+                _history.pop_back();
+        }
+
+    _tasks.erase(std::remove_if(_tasks.begin(), _tasks.end(), [](const Task &task) {
+        return task.cancelled || task.stats.finished;
+    }), _tasks.end());
+
+    for (Task &task : _incoming)
+        if (!task.cancelled)
+            _tasks.push_back(std::move(task));
+    _incoming.clear();
+}
+
+UNIFIED_END_NAMESPACE
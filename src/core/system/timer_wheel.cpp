@@ -0,0 +1,263 @@
+#include <unified/core/system/timer_wheel.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <algorithm>
+
+UNIFIED_BEGIN_NAMESPACE
+
+TimerWheel::TimerWheel(Time resolution)
+    : _now(), _resolution(resolution), _current(0), _nodes(), _free(none), _count(0), _expired() {
+    if (resolution <= Time())
+        throw Exceptions::misbehavior("bad timer resolution");
+
+    std::fill(std::begin(_slots), std::end(_slots), none);
+}
+
+TimerWheel::Handle TimerWheel::schedule(Time delay, callback_fn callback, Time period) {
+    if (!callback)
+        throw Exceptions::misbehavior("bad timer callback");
+
+    const u32 index = allocate();
+    Node &node = _nodes[index];
+
+    node.callback = std::move(callback);
+    node.due = std::max(_current + 1, to_ticks(_now + delay));
+    node.period = period > Time() ? std::max<u64>(to_ticks(period), 1) : 0;
+    node.state = State::Pending;
+
+    insert(index);
+    ++_count;
+
+    return (static_cast<Handle>(node.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(Handle handle) {
+    const u32 index = static_cast<u32>(handle);
+    if (index >= _nodes.size())
+        return false;
+
+    Node &node = _nodes[index];
+    if (node.generation != static_cast<u32>(handle >> 32))
+        return false;
+
+    switch (node.state) {
+        case State::Pending:
+            unlink(index);
+            release(index);
+            --_count;
+            return true;
+        case State::Firing:
+            // it is in the batch advance() is working through, either running or still to come.
+            // advance() skips and releases it
+            node.state = State::Cancelled;
+            return true;
+        default:
+            return false;
+    }
+}
+
+u32 TimerWheel::advance(Time now) {
+    _now = std::max(_now, now);
+    const u64 target = to_ticks(_now);
+
+    if (!_count) {
+        _current = std::max(_current, target);
+        return 0;
+    }
+
+    _expired.clear();
+
+    while (_current < target) {
+        ++_current;
+
+        // when a level wraps, the next coarser slot is due and gets spread over the finer levels
+        if (!(_current & (slot_count - 1))) {
+            u32 level = 1;
+            while (level < level_count - 1 && !((_current >> (level * slot_bits)) & (slot_count - 1)))
+                ++level;
+            for (; level > 0; --level)
+                cascade(level);
+        }
+
+        expire(static_cast<u32>(_current & (slot_count - 1)));
+    }
+
+    // a callback that throws is dropped, the rest of its batch goes back in to fire on the next advance()
+    struct ScopeBatch
+    {
+        explicit ScopeBatch(TimerWheel &wheel) : _wheel(wheel), _position(0) { }
+        ~ScopeBatch() {
+            for (; _position < _wheel._expired.size(); ++_position) {
+                const u32 index = _wheel._expired[_position];
+                Node &node = _wheel._nodes[index];
+
+                // only the one that threw has its callback moved out
+                if (node.state != State::Firing || !node.callback) {
+                    _wheel.release(index);
+                    --_wheel._count;
+                    continue;
+                }
+
+                node.due = std::max(node.due, _wheel._current + 1);
+                node.state = State::Pending;
+                _wheel.insert(index);
+            }
+            _wheel._expired.clear();
+        }
+
+        TimerWheel &_wheel;
+        std::size_t _position;
+    } batch(*this);
+
+    u32 fired = 0;
+
+    for (; batch._position < _expired.size(); ++batch._position) {
+        const u32 index = _expired[batch._position];
+
+        // an earlier callback of this batch may have cancelled it
+        if (_nodes[index].state != State::Firing) {
+            release(index);
+            --_count;
+            continue;
+        }
+
+        // moved out, the callback may schedule new timers and grow the node storage
+        callback_fn callback = std::move(_nodes[index].callback);
+        _nodes[index].callback = nullptr;
+        callback();
+        ++fired;
+
+        Node &node = _nodes[index];
+        if (node.state == State::Firing && node.period) {
+            node.callback = std::move(callback);
+            node.due = std::max(node.due + node.period, _current + 1);
+            node.state = State::Pending;
+            insert(index);
+        } else {
+            release(index);
+            --_count;
+        }
+    }
+
+    return fired;
+}
+
+UNIFIED_NODISCARD Time TimerWheel::get_time() const {
+    return _now;
+}
+
+UNIFIED_NODISCARD u32 TimerWheel::get_count() const {
+    return _count;
+}
+
+UNIFIED_NODISCARD Time TimerWheel::get_next_due() const {
+    for (u64 tick = _current + 1; tick <= _current + slot_count; ++tick) {
+        if (_slots[tick & (slot_count - 1)] != none)
+            return _resolution * static_cast<s64>(tick);
+        // past the wrap the next cascade may bring in earlier timers
+        if (!(tick & (slot_count - 1)))
+            break;
+    }
+
+    const u64 wrap = ((_current >> slot_bits) + 1) << slot_bits;
+    return _resolution * static_cast<s64>(wrap);
+}
+
+UNIFIED_NODISCARD Time TimerWheel::get_resolution() const {
+    return _resolution;
+}
+
+u32 TimerWheel::allocate() {
+    if (_free == none) {
+        _nodes.push_back(Node { nullptr, 0, 0, 0, none, none, none, State::Free });
+        return static_cast<u32>(_nodes.size() - 1);
+    }
+
+    const u32 index = _free;
+    _free = _nodes[index].next;
+    return index;
+}
+
+void TimerWheel::release(u32 index) {
+    Node &node = _nodes[index];
+
+    node.callback = nullptr;
+    node.state = State::Free;
+    ++node.generation;
+
+    node.next = _free;
+    _free = index;
+}
+
+void TimerWheel::insert(u32 index) {
+    Node &node = _nodes[index];
+
+    const u64 delta = node.due > _current ? node.due - _current : 0;
+
+    u32 level = 0;
+    while (level < level_count - 1 && delta >= (u64(1) << ((level + 1) * slot_bits)))
+        ++level;
+
+    // beyond the last level the timer waits in the farthest slot and is cascaded again from there
+    u64 due = node.due;
+    const u64 range = u64(1) << (level_count * slot_bits);
+    if (delta >= range)
+        due = _current + range - 1;
+
+    node.slot = level * slot_count + static_cast<u32>((due >> (level * slot_bits)) & (slot_count - 1));
+    node.prev = none;
+    node.next = _slots[node.slot];
+
+    if (node.next != none)
+        _nodes[node.next].prev = index;
+    _slots[node.slot] = index;
+}
+
+void TimerWheel::unlink(u32 index) {
+    Node &node = _nodes[index];
+
+    if (node.prev != none)
+        _nodes[node.prev].next = node.next;
+    else
+        _slots[node.slot] = node.next;
+
+    if (node.next != none)
+        _nodes[node.next].prev = node.prev;
+
+    node.prev = node.next = none;
+}
+
+void TimerWheel::cascade(u32 level) {
+    const u32 slot = level * slot_count + static_cast<u32>((_current >> (level * slot_bits)) & (slot_count - 1));
+
+    u32 index = _slots[slot];
+    _slots[slot] = none;
+
+    while (index != none) {
+        const u32 next = _nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::expire(u32 slot) {
+    u32 index = _slots[slot];
+    _slots[slot] = none;
+
+    while (index != none) {
+        Node &node = _nodes[index];
+        const u32 next = node.next;
+
+        node.prev = node.next = none;
+        node.state = State::Firing;
+        _expired.push_back(index);
+
+        index = next;
+    }
+}
+
+UNIFIED_NODISCARD u64 TimerWheel::to_ticks(Time time) const {
+    return time > Time() ? static_cast<u64>(time.asNanoseconds() / _resolution.asNanoseconds()) : 0;
+}
+
+UNIFIED_END_NAMESPACE
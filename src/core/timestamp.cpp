@@ -0,0 +1,33 @@
+#include <unified/core/timestamp.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+
+UNIFIED_NODISCARD double get_timestamp_frequency() {
+# if defined(UNIFIED_TIMESTAMP_TSC)
+    // the counter rate is measured once against the monotonic clock over a short busy interval
+    static const double frequency = [] {
+        Time start_time = get_current_time();
+        Timestamp start_ticks = get_timestamp();
+
+        Time elapsed;
+        do {
+            elapsed = get_current_time() - start_time;
+        } while (elapsed < milliseconds(10));
+
+        return static_cast<double>(get_timestamp() - start_ticks) / elapsed.asSeconds();
+    }();
+    return frequency;
+# else
+    return 1000000000.0;
+# endif
+}
+
+UNIFIED_NODISCARD Time timestamp_to_time(Timestamp ticks) {
+# if defined(UNIFIED_TIMESTAMP_TSC)
+    return seconds(static_cast<double>(ticks) / get_timestamp_frequency());
+# else
+    return nanoseconds(static_cast<s64>(ticks));
+# endif
+}
+
+UNIFIED_END_NAMESPACE
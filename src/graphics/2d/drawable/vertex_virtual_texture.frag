@@ -0,0 +1,32 @@
+R"glsl(
+
+#version 330 core
+
+out vec4 fragment_color;
+
+in vec2 out_texture_coord;
+
+uniform sampler2D page_cache;
+uniform sampler2D page_table;
+
+uniform vec2 pages;
+uniform vec2 image_size;
+uniform float page_size;
+uniform float slot_size;
+uniform float cache_size;
+
+void main()
+{
+    // the last row and column of pages may be partly empty, uv 1.0 is the image edge and not the page grid edge
+    vec2 page_coord = out_texture_coord * image_size / page_size;
+    ivec2 page = clamp(ivec2(page_coord), ivec2(0), ivec2(pages) - 1);
+
+    vec4 entry = texelFetch(page_table, page, 0);
+    if (entry.b < 0.5)
+        discard;
+
+    vec2 texel = floor(entry.rg * 255.0 + 0.5) * slot_size + 1.0 + (page_coord - vec2(page)) * page_size;
+    fragment_color = texture(page_cache, texel / cache_size);
+}
+
+)glsl"
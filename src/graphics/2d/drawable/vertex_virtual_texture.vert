@@ -0,0 +1,16 @@
+R"glsl(
+
+#version 330 core
+
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 texture_coord;
+
+out vec2 out_texture_coord;
+
+void main()
+{
+    gl_Position = vec4(position, 0.0, 1.0);
+    out_texture_coord = texture_coord;
+}
+
+)glsl"
@@ -0,0 +1,352 @@
+#include <unified/graphics/2d/drawable/virtual_texture.hpp>
+#include <unified/core/math/point3.hpp>
+#include <unified/core/exceptions.hpp>
+#include <unified/graphics/shader.hpp>
+#include <unified/graphics/image/qoi.hpp>
+
+#include <stb_image.h>
+#include <glad/glad.h>
+
+#include <initializer_list>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+using namespace Unified::Graphics;
+
+namespace
+{
+    using UNIFIED_NAMESPACE::u32;
+
+    UNIFIED_CONSTEXPR char page_file_magic[4] = { 'U', 'V', 'T', 'P' };
+    UNIFIED_CONSTEXPR u32 page_file_version = 1;
+    UNIFIED_CONSTEXPR u32 page_table_limit = 256;
+
+    u32 cache_side_for(u32 cache_pages, u32 slot_size) {
+        GLint max_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+
+        auto side = static_cast<u32>(std::ceil(std::sqrt(static_cast<double>(std::max(cache_pages, 1u)))));
+        side = std::min(side, page_table_limit);
+
+        if (max_size > 0)
+            side = std::min(side, static_cast<u32>(max_size) / slot_size);
+
+        if (!side)
+            throw UNIFIED_NAMESPACE::Exceptions::initialization_failed("virtual texture pages do not fit into a texture");
+
+        return side;
+    }
+}
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_2D_BEGIN_NAMESPACE
+
+VirtualTexture::VirtualTexture(string page_file, u32 cache_pages, Buffer::Usage usage)
+    : _file(page_file, std::ios::binary), _header(read_header(_file)),
+      _pages((_header.width + _header.page_size - 1) / _header.page_size, (_header.height + _header.page_size - 1) / _header.page_size),
+      _slot_size(_header.page_size + 2), _cache_side(cache_side_for(cache_pages, _slot_size)),
+      _cache(Point2i(_cache_side * _slot_size), Texture::Format::RGBA8, 0),
+      _indirection(_pages, Texture::Format::RGBA8, 0),
+      _buffer(usage),
+      _slots(_cache_side * _cache_side, Slot { -1, 0 }),
+      _page_slots(static_cast<size_t>(_pages.x) * _pages.y, -1),
+      _table(static_cast<size_t>(_pages.x) * _pages.y * 4, 0),
+      _staging(static_cast<size_t>(_slot_size) * _slot_size * 4),
+      _table_dirty(true),
+      _bounds_position(-1.0, -1.0), _bounds_size(2.0, 2.0),
+      _upload_limit(16), _frame(0) {
+    GLint max_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+
+    if (_pages.x > max_size || _pages.y > max_size)
+        throw Exceptions::initialization_failed("virtual texture has too many pages");
+
+    _buffer.allocate(sizeof(Vertex2d) * 4);
+}
+
+void VirtualTexture::build(string image, string page_file, u32 page_size) {
+    std::ifstream input(image, std::ios::binary);
+    if (!input)
+        throw Exceptions::misbehavior("failed to load image");
+
+    char magic[4] = { };
+    input.read(magic, sizeof(magic));
+    input.clear();
+    input.seekg(0);
+
+    // only the rows of one band of pages are ever decoded at a time
+    if (std::memcmp(magic, "qoif", 4) == 0) {
+        Qoi::Decoder decoder(input);
+        const Qoi::Description &description = decoder.get_description();
+
+        std::vector<u8> row(static_cast<size_t>(description.width) * description.channels);
+
+        build([&](u32, u8 *pixels) {
+            decoder.read_row(row.data());
+            for (u32 x = 0; x < description.width; ++x) {
+                const u8 *source = &row[static_cast<size_t>(x) * description.channels];
+                pixels[x * 4 + 0] = source[0], pixels[x * 4 + 1] = source[1], pixels[x * 4 + 2] = source[2];
+                pixels[x * 4 + 3] = description.channels == 4 ? source[3] : 255;
+            }
+        }, Point2i(static_cast<int>(description.width), static_cast<int>(description.height)), page_file, page_size);
+        return;
+    }
+
+    input.close();
+
+    int width, height, channels;
+
+    auto buffer = stbi_load(image.c_str(), &width, &height, &channels, 4);
+
+    if (!buffer)
+        throw Exceptions::misbehavior("failed to load image");
+
+    try {
+        build(buffer, Point2i(width, height), page_file, page_size);
+    } catch (...) {
+        stbi_image_free(buffer);
+        throw;
+    }
+
+    stbi_image_free(buffer);
+}
+
+void VirtualTexture::build(const u8 *pixels, Point2i size, string page_file, u32 page_size) {
+    if (!pixels)
+        throw Exceptions::misbehavior("bad virtual texture source");
+
+    const size_t row_size = static_cast<size_t>(size.x) * 4;
+    build([pixels, row_size](u32 row, u8 *destination) {
+        std::memcpy(destination, pixels + row * row_size, row_size);
+    }, size, page_file, page_size);
+}
+
+void VirtualTexture::build(const row_reader_fn &read_row, Point2i size, string page_file, u32 page_size) {
+    if (!read_row || size.x <= 0 || size.y <= 0 || !page_size)
+        throw Exceptions::misbehavior("bad virtual texture source");
+
+    std::ofstream file(page_file, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+        throw Exceptions::misbehavior("failed to create page file");
+
+    Header header { { }, page_file_version, static_cast<u32>(size.x), static_cast<u32>(size.y), page_size };
+    std::memcpy(header.magic, page_file_magic, sizeof(header.magic));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    int slot_size = static_cast<int>(page_size) + 2;
+    int pages_x = (size.x + page_size - 1) / page_size;
+    int pages_y = (size.y + page_size - 1) / page_size;
+
+    std::vector<u8> page(static_cast<size_t>(slot_size) * slot_size * 4);
+
+    // a band of pages spans at most slot_size source rows, so row r lives at r % slot_size until it is no longer needed
+    const size_t row_size = static_cast<size_t>(size.x) * 4;
+    std::vector<u8> rows(row_size * slot_size);
+    int rows_read = 0;
+
+    // every page carries a one texel border copied from its neighbours so filtering does not bleed across slots
+    for (int page_y = 0; page_y < pages_y; ++page_y) {
+        const int last_row = std::min(page_y * static_cast<int>(page_size) + static_cast<int>(page_size), size.y - 1);
+        for (; rows_read <= last_row; ++rows_read)
+            read_row(static_cast<u32>(rows_read), &rows[static_cast<size_t>(rows_read % slot_size) * row_size]);
+
+        for (int page_x = 0; page_x < pages_x; ++page_x) {
+            for (int y = 0; y < slot_size; ++y) {
+                int source_y = std::min(std::max(page_y * static_cast<int>(page_size) + y - 1, 0), size.y - 1);
+                const u8 *row = &rows[static_cast<size_t>(source_y % slot_size) * row_size];
+                for (int x = 0; x < slot_size; ++x) {
+                    int source_x = std::min(std::max(page_x * static_cast<int>(page_size) + x - 1, 0), size.x - 1);
+                    std::memcpy(&page[(static_cast<size_t>(y) * slot_size + x) * 4], &row[static_cast<size_t>(source_x) * 4], 4);
+                }
+            }
+            file.write(reinterpret_cast<const char*>(page.data()), static_cast<std::streamsize>(page.size()));
+        }
+    }
+
+    if (!file)
+        throw Exceptions::misbehavior("failed to write page file");
+}
+
+void VirtualTexture::set_bounds(const Point2d &position, const Point2d &size) {
+    _bounds_position = position, _bounds_size = size;
+}
+
+void VirtualTexture::set_upload_limit(u32 pages) {
+    _upload_limit = pages;
+}
+
+void VirtualTexture::update(const Camera &camera) {
+    ++_frame;
+
+    // the visible region is whatever the projection maps onto the screen, so the corners of normalized
+    // device space go back through its inverse. a rotated camera sees their bounding box
+    const Projection unproject = inverse(camera.get_projection());
+
+    Point2d visible_low(std::numeric_limits<double>::max()), visible_high(std::numeric_limits<double>::lowest());
+    for (const Point2d &corner : { Point2d(-1.0, -1.0), Point2d(1.0, -1.0), Point2d(1.0, 1.0), Point2d(-1.0, 1.0) }) {
+        const Point3d point = unproject * Point3d(corner.x, corner.y, 1.0);
+        const Point2d world(point.x / point.z, point.y / point.z);
+
+        visible_low = Point2d(std::min(visible_low.x, world.x), std::min(visible_low.y, world.y));
+        visible_high = Point2d(std::max(visible_high.x, world.x), std::max(visible_high.y, world.y));
+    }
+
+    double u0 = (visible_low.x - _bounds_position.x) / _bounds_size.x;
+    double u1 = (visible_high.x - _bounds_position.x) / _bounds_size.x;
+    double v0 = (_bounds_position.y + _bounds_size.y - visible_high.y) / _bounds_size.y;
+    double v1 = (_bounds_position.y + _bounds_size.y - visible_low.y) / _bounds_size.y;
+
+    if (u1 > 0.0 && u0 < 1.0 && v1 > 0.0 && v0 < 1.0) {
+        auto page_index = [this](double coord, u32 extent, int count) {
+            return std::min(std::max(static_cast<int>(std::floor(coord * extent / _header.page_size)), 0), count - 1);
+        };
+
+        Point2i first(page_index(u0, _header.width, _pages.x), page_index(v0, _header.height, _pages.y));
+        Point2i last(page_index(u1, _header.width, _pages.x), page_index(v1, _header.height, _pages.y));
+
+        for (int y = first.y; y <= last.y; ++y)
+            for (int x = first.x; x <= last.x; ++x) {
+                s32 slot = _page_slots[static_cast<size_t>(y) * _pages.x + x];
+                if (slot >= 0)
+                    _slots[slot].last_used = _frame;
+            }
+
+        u32 uploads = 0;
+        for (int y = first.y; y <= last.y && uploads < _upload_limit; ++y)
+            for (int x = first.x; x <= last.x && uploads < _upload_limit; ++x) {
+                s32 page = y * _pages.x + x;
+                if (_page_slots[page] >= 0)
+                    continue;
+
+                s32 slot = acquire_slot();
+                if (slot < 0)
+                    break;
+
+                load_page(page, slot), ++uploads;
+            }
+    }
+
+    if (_table_dirty)
+        _indirection.update(_table.data()), _table_dirty = false;
+
+    auto project = [&](double x, double y) -> Point2d {
+        return camera.get_projection() * Point3d(x, y, 1.0);
+    };
+
+    Point2d low = _bounds_position, high = _bounds_position + _bounds_size;
+
+    Vertex2d vertices[4] =
+    { { project(low.x,  low.y),  { 0.0, 1.0 } },
+      { project(low.x,  high.y), { 0.0, 0.0 } },
+      { project(high.x, high.y), { 1.0, 0.0 } },
+      { project(high.x, low.y),  { 1.0, 1.0 } } };
+
+    _buffer.write(vertices, sizeof(vertices));
+}
+
+void VirtualTexture::draw(const RenderTarget&, const Graphics::Shader *shader) const {
+    Buffer::ScopeBind buffer_bind(&_buffer);
+
+    glVertexAttribPointer(0, 2, GL_DOUBLE, GL_FALSE,
+        sizeof(Vertex2d), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 2, GL_DOUBLE, GL_FALSE,
+        sizeof(Vertex2d), (void*)(sizeof(Point2d) + sizeof(Color)));
+    glEnableVertexAttribArray(1);
+
+    static Shader static_shader(
+        #include "vertex_virtual_texture.vert"
+            ,
+        #include "vertex_virtual_texture.frag"
+    );
+
+    Shader *program = shader ? const_cast<Shader*>(shader) : &static_shader;
+    Shader::ScopeBind shader_bind(program);
+
+    program->set_int("page_cache", 0);
+    program->set_int("page_table", 1);
+    program->set_float2("pages", Point2f(static_cast<float>(_pages.x), static_cast<float>(_pages.y)));
+    program->set_float2("image_size", Point2f(static_cast<float>(_header.width), static_cast<float>(_header.height)));
+    program->set_float("page_size", static_cast<float>(_header.page_size));
+    program->set_float("slot_size", static_cast<float>(_slot_size));
+    program->set_float("cache_size", static_cast<float>(_cache_side * _slot_size));
+
+    Graphics::Texture::bind(&_indirection, 1);
+    glActiveTexture(GL_TEXTURE0);
+
+    Graphics::Texture::ScopeBind texture_bind(&_cache);
+
+    glDrawArrays(static_cast<GLenum>(Graphics::PrimitiveType::Quads), 0, 4);
+
+    glDisableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+}
+
+UNIFIED_NODISCARD Point2i VirtualTexture::get_size() const {
+    return Point2i(static_cast<int>(_header.width), static_cast<int>(_header.height));
+}
+
+UNIFIED_NODISCARD u32 VirtualTexture::get_page_size() const {
+    return _header.page_size;
+}
+
+UNIFIED_NODISCARD u32 VirtualTexture::get_resident_pages() const {
+    return static_cast<u32>(std::count_if(_slots.begin(), _slots.end(), [](const Slot &slot) { return slot.page >= 0; }));
+}
+
+VirtualTexture::Header VirtualTexture::read_header(std::ifstream &file) {
+    Header header;
+
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        throw Exceptions::initialization_failed("failed to read page file");
+
+    if (std::memcmp(header.magic, page_file_magic, sizeof(header.magic)) != 0 || header.version != page_file_version || !header.page_size)
+        throw Exceptions::initialization_failed("bad page file");
+
+    return header;
+}
+
+s32 VirtualTexture::acquire_slot() {
+    s32 result = -1;
+
+    for (s32 i = 0; i < static_cast<s32>(_slots.size()); ++i)
+        if (_slots[i].last_used != _frame && (result < 0 || _slots[i].last_used < _slots[result].last_used))
+            result = i;
+
+    if (result >= 0 && _slots[result].page >= 0) {
+        s32 page = _slots[result].page;
+        _page_slots[page] = -1;
+        _table[static_cast<size_t>(page) * 4 + 2] = 0;
+        _table_dirty = true;
+    }
+
+    return result;
+}
+
+void VirtualTexture::load_page(s32 page, s32 slot) {
+    auto offset = static_cast<std::streamoff>(sizeof(Header)) + static_cast<std::streamoff>(page) * static_cast<std::streamoff>(_staging.size());
+
+    _file.clear();
+    if (!_file.seekg(offset) || !_file.read(reinterpret_cast<char*>(_staging.data()), static_cast<std::streamsize>(_staging.size())))
+        throw Exceptions::misbehavior("failed to read virtual texture page");
+
+    Point2i position((slot % _cache_side) * _slot_size, (slot / _cache_side) * _slot_size);
+    _cache.update(StreamingTexture::Region(position, Point2i(_slot_size)), _staging.data());
+
+    u8 *entry = &_table[static_cast<size_t>(page) * 4];
+    entry[0] = static_cast<u8>(slot % _cache_side);
+    entry[1] = static_cast<u8>(slot / _cache_side);
+    entry[2] = 255;
+    entry[3] = 255;
+
+    _page_slots[page] = slot;
+    _slots[slot] = Slot { page, _frame };
+    _table_dirty = true;
+}
+
+UNIFIED_GRAPHICS_2D_END_NAMESPACE
+UNIFIED_END_NAMESPACE
@@ -1,5 +1,8 @@
 ﻿#include <unified/graphics/buffer.hpp>
+#include <unified/graphics/context_owner.hpp>
 #include <unified/core/exceptions.hpp>
+#include <unified/core/memory/frame_arena.hpp>
+#include <unified/core/memory/memory_tracker.hpp>
 #include <glad/glad.h>
 
 namespace
@@ -16,19 +19,23 @@ namespace
 UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
 
-Buffer::Buffer(Usage usage) : _usage(usage) {
-    glGenBuffers(1, &_id);
-    if (!_id)
+Buffer::Buffer(Usage usage) : _resource(0), _usage(usage), _gpu_size(0) {
+    _id = ResourceManager::acquire(ResourceManager::Type::Buffer, _resource);
+    if (!_id && !_resource)
         throw Exceptions::initialization_failed("failed to initialize the graphics buffer");
 }
 
 Buffer::~Buffer() {
-    glDeleteBuffers(1, &_id);
+    ResourceManager::release(ResourceManager::Type::Buffer, _resource, _id);
+    MemoryTracker::record_gpu(MemoryTag::Buffers, -static_cast<s64>(_gpu_size));
 }
 
 void Buffer::allocate(u32 size) {
     ScopeBind bind(this);
     glBufferData(GL_ARRAY_BUFFER, size, 0, usage_to_glenum(_usage));
+
+    MemoryTracker::record_gpu(MemoryTag::Buffers, static_cast<s64>(size) - static_cast<s64>(_gpu_size));
+    _gpu_size = size;
 }
 
 void Buffer::reallocate(u32 size) {
@@ -42,10 +49,15 @@ void Buffer::reallocate(u32 size) {
     if (old_size > size)
         throw Exceptions::misbehavior("impossible to reallocate less memory than already allocated. possible data loss");
 
-    s8 *old_data = new s8[old_size];
-    glGetBufferSubData(GL_ARRAY_BUFFER, 0, old_size, (void*)old_data);
-    glBufferData(GL_ARRAY_BUFFER, size, (void*)old_data, usage_to_glenum(_usage));
-    delete[] old_data;
+    FrameArena &arena = FrameArena::local();
+
+    void *old_data = arena.allocate(old_size);
+    glGetBufferSubData(GL_ARRAY_BUFFER, 0, old_size, old_data);
+    glBufferData(GL_ARRAY_BUFFER, size, old_data, usage_to_glenum(_usage));
+    arena.deallocate(old_data, old_size);
+
+    MemoryTracker::record_gpu(MemoryTag::Buffers, static_cast<s64>(size) - static_cast<s64>(_gpu_size));
+    _gpu_size = size;
 
     return;
 }
@@ -61,6 +73,9 @@ void Buffer::read(void *data, u32 size, u32 offset) {
 }
 
 UNIFIED_NODISCARD Buffer::HandleType Buffer::handle() const{
+    // created off the GL thread while the pool was empty, the name is known once the manager handed it out
+    if (!_id && _resource && ResourceManager::current)
+        _id = ResourceManager::current->realize(_resource);
     return _id;
 }
 
@@ -85,16 +100,20 @@ void Buffer::bind(const Buffer *buffer) {
     if (!buffer)
         throw Exceptions::misbehavior("bad " UNIFIED_GRAPHICS_NAMESPACE_STRING "::Buffer pointer");
 
+    ContextOwner::check();
     glBindBuffer(GL_ARRAY_BUFFER, buffer->handle());
 }
 
 void Buffer::unbind() {
+    ContextOwner::check();
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 Buffer *Buffer::ScopeBind::current = 0;
 
 Buffer::ScopeBind::ScopeBind(const Buffer *buffer) {
+    ContextOwner::check();
+
     if (current && (current->handle() == buffer->handle())) {
         _prev = 0;
         return;
@@ -0,0 +1,76 @@
+#include <unified/graphics/command_buffer.hpp>
+#include <unified/core/exceptions.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+CommandBuffer::CommandBuffer(u32 lanes) : _lanes(lanes ? lanes : 1), _sorted(), _scratch() { }
+
+void CommandBuffer::record(u32 lane, u64 key, const Drawable &object, const Shader *shader) {
+    if (lane >= _lanes.size())
+        throw Exceptions::misbehavior("bad command buffer lane");
+
+    _lanes[lane].packets.push_back(Packet { key, &object, shader });
+}
+
+void CommandBuffer::sort() {
+    std::size_t total = 0;
+    for (const Lane &lane : _lanes)
+        total += lane.packets.size();
+
+    _sorted.clear();
+    _sorted.reserve(total);
+    for (const Lane &lane : _lanes)
+        _sorted.insert(_sorted.end(), lane.packets.begin(), lane.packets.end());
+
+    // least significant digit radix sort, one byte per pass. bytes every key shares are skipped,
+    // which with the usual keys leaves only a few passes
+    u64 differing = 0;
+    for (const Packet &packet : _sorted)
+        differing |= packet.key ^ _sorted.front().key;
+
+    _scratch.resize(total);
+
+    for (u32 shift = 0; shift < 64; shift += 8) {
+        if (!((differing >> shift) & 0xff))
+            continue;
+
+        std::size_t offsets[256] = { };
+        for (const Packet &packet : _sorted)
+            ++offsets[(packet.key >> shift) & 0xff];
+
+        std::size_t sum = 0;
+        for (std::size_t &offset : offsets) {
+            const std::size_t count = offset;
+            offset = sum, sum += count;
+        }
+
+        for (const Packet &packet : _sorted)
+            _scratch[offsets[(packet.key >> shift) & 0xff]++] = packet;
+
+        _sorted.swap(_scratch);
+    }
+}
+
+void CommandBuffer::submit(const RenderTarget &target) const {
+    for (const Packet &packet : _sorted)
+        target.draw(*packet.object, packet.shader);
+}
+
+void CommandBuffer::reset() {
+    // capacity is kept, so after the first frames recording is a plain linear append
+    for (Lane &lane : _lanes)
+        lane.packets.clear();
+    _sorted.clear();
+}
+
+UNIFIED_NODISCARD u32 CommandBuffer::get_lane_count() const {
+    return static_cast<u32>(_lanes.size());
+}
+
+UNIFIED_NODISCARD u32 CommandBuffer::size() const {
+    return static_cast<u32>(_sorted.size());
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
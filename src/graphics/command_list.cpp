@@ -0,0 +1,58 @@
+#include <unified/graphics/command_list.hpp>
+#include <unified/graphics/render_target.hpp>
+#include <unified/graphics/texture_residency.hpp>
+#include <glad/glad.h>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+CommandList::CommandList() : _commands(), _functions() { }
+
+void CommandList::clear(const Color &color) {
+    Command command { Type::Clear, color, nullptr, nullptr, 0 };
+    _commands.push_back(command);
+}
+
+void CommandList::draw(const Drawable &object, const Shader *shader) {
+    Command command { Type::Draw, Color(), &object, shader, 0 };
+    _commands.push_back(command);
+}
+
+void CommandList::invoke(std::function<void()> function) {
+    Command command { Type::Invoke, Color(), nullptr, nullptr, static_cast<u32>(_functions.size()) };
+    _functions.push_back(std::move(function));
+    _commands.push_back(command);
+}
+
+void CommandList::execute(const RenderTarget &target) const {
+    for (const Command &command : _commands)
+        switch (command.type) {
+            case Type::Clear:
+                glClearColor(command.color.r, command.color.g, command.color.b, command.color.a);
+                glClear(GL_COLOR_BUFFER_BIT);
+                break;
+            case Type::Draw:
+                command.object->draw(target, command.shader);
+                TextureResidency::next_draw();
+                break;
+            case Type::Invoke:
+                _functions[command.function]();
+                break;
+        }
+}
+
+void CommandList::reset() {
+    _commands.clear();
+    _functions.clear();
+}
+
+UNIFIED_NODISCARD bool CommandList::empty() const {
+    return _commands.empty();
+}
+
+UNIFIED_NODISCARD u32 CommandList::size() const {
+    return static_cast<u32>(_commands.size());
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,26 @@
+#include <unified/graphics/context_owner.hpp>
+#include <unified/core/exceptions.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+std::atomic<bool> ContextOwner::_tracked(false);
+std::atomic<std::thread::id> ContextOwner::_owner;
+
+void ContextOwner::acquire() {
+    _owner.store(std::this_thread::get_id(), std::memory_order_release);
+    _tracked.store(true, std::memory_order_release);
+}
+
+void ContextOwner::release() {
+    _owner.store(std::thread::id(), std::memory_order_release);
+    _tracked.store(true, std::memory_order_release);
+}
+
+void ContextOwner::check() {
+    if (_tracked.load(std::memory_order_acquire) && _owner.load(std::memory_order_acquire) != std::this_thread::get_id())
+        throw Exceptions::misbehavior("GL call from a thread that does not own the context");
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,70 @@
+#include <unified/graphics/frame_fence.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <glad/glad.h>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+FrameFence::FrameFence(u32 frames_in_flight)
+    : _fences(), _first(0), _count(0), _frames_in_flight(0), _last_wait(0), _total_wait(0) {
+    set_frames_in_flight(frames_in_flight);
+}
+
+FrameFence::~FrameFence() {
+    while (_count)
+        release_front();
+}
+
+UNIFIED_NODISCARD u32 FrameFence::get_frames_in_flight() const {
+    return _frames_in_flight;
+}
+
+void FrameFence::set_frames_in_flight(u32 frames) {
+    if (frames == 0 || frames > max_frames_in_flight)
+        throw Exceptions::misbehavior("bad frames in flight count");
+    _frames_in_flight = frames;
+}
+
+Time FrameFence::wait() {
+    const Time start = get_current_time();
+
+    // fences the GPU already passed are dropped first so they never count against the limit
+    while (_count && glClientWaitSync(static_cast<GLsync>(_fences[_first]), 0, 0) != GL_TIMEOUT_EXPIRED)
+        release_front();
+
+    while (_count >= _frames_in_flight) {
+        GLenum status = glClientWaitSync(static_cast<GLsync>(_fences[_first]), GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+        if (status != GL_TIMEOUT_EXPIRED)
+            release_front();
+    }
+
+    const Time waited = get_current_time() - start;
+    _last_wait.store(waited.asNanoseconds(), std::memory_order_relaxed);
+    _total_wait.fetch_add(waited.asNanoseconds(), std::memory_order_relaxed);
+    return waited;
+}
+
+void FrameFence::submit() {
+    if (_count == max_frames_in_flight)
+        release_front();
+
+    _fences[(_first + _count++) % max_frames_in_flight] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+UNIFIED_NODISCARD Time FrameFence::get_last_wait() const {
+    return nanoseconds(_last_wait.load(std::memory_order_relaxed));
+}
+
+UNIFIED_NODISCARD Time FrameFence::get_total_wait() const {
+    return nanoseconds(_total_wait.load(std::memory_order_relaxed));
+}
+
+void FrameFence::release_front() {
+    glDeleteSync(static_cast<GLsync>(_fences[_first]));
+    _first = (_first + 1) % max_frames_in_flight;
+    --_count;
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
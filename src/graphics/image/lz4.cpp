@@ -0,0 +1,262 @@
+#include <unified/graphics/image/lz4.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    using UNIFIED_NAMESPACE::u8;
+    using UNIFIED_NAMESPACE::u32;
+    using UNIFIED_NAMESPACE::u64;
+
+    UNIFIED_CONSTEXPR u32 min_match = 4;
+    UNIFIED_CONSTEXPR u32 last_literals = 5;
+    UNIFIED_CONSTEXPR u32 match_limit = 12;
+    UNIFIED_CONSTEXPR u32 max_offset = 65535;
+    UNIFIED_CONSTEXPR u32 hash_bits = 16;
+
+    UNIFIED_CONSTEXPR u32 block_size = 4 << 20;
+    UNIFIED_CONSTEXPR u32 container_version = 1;
+
+    struct container_header
+    {
+        char magic[4];
+        u32 version;
+        u32 width, height;
+        u32 format;
+        u32 block_size;
+        u32 block_count;
+    };
+
+    UNIFIED_FORCE_INLINE u32 read_u32(const u8 *data) {
+        u32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    UNIFIED_FORCE_INLINE u32 hash(u32 sequence) {
+        return (sequence * 2654435761u) >> (32 - hash_bits);
+    }
+
+    void write_length(std::vector<u8> &out, u32 length) {
+        for (; length >= 255; length -= 255)
+            out.push_back(255);
+        out.push_back(static_cast<u8>(length));
+    }
+
+    void write_sequence(std::vector<u8> &out, const u8 *literals, u32 literal_length, u32 offset, u32 match_length) {
+        size_t token = out.size();
+
+        out.push_back(static_cast<u8>(std::min(literal_length, 15u) << 4));
+        if (literal_length >= 15)
+            write_length(out, literal_length - 15);
+
+        out.insert(out.end(), literals, literals + literal_length);
+
+        if (!match_length)
+            return;
+
+        out.push_back(static_cast<u8>(offset));
+        out.push_back(static_cast<u8>(offset >> 8));
+
+        u32 length = match_length - min_match;
+        out[token] |= static_cast<u8>(std::min(length, 15u));
+        if (length >= 15)
+            write_length(out, length - 15);
+    }
+
+    UNIFIED_FORCE_INLINE u32 read_length(const u8 *&input, const u8 *input_end, u32 length) {
+        if (length != 15)
+            return length;
+
+        u8 byte;
+        do {
+            if (input >= input_end)
+                throw UNIFIED_NAMESPACE::Exceptions::misbehavior("truncated lz4 block");
+            byte = *input++;
+            length += byte;
+        } while (byte == 255);
+
+        return length;
+    }
+
+    bool read_container(const u8 *data, u64 size, container_header &header) {
+        if (!data || size < sizeof(header))
+            return false;
+
+        std::memcpy(&header, data, sizeof(header));
+        return std::memcmp(header.magic, "ULZ4", 4) == 0 && header.version == container_version &&
+            header.width && header.height && header.format <= static_cast<u32>(UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Texture::Format::RGBA16F) &&
+            header.block_size;
+    }
+}
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+namespace Lz4
+{
+    UNIFIED_NODISCARD u64 compress_block(const u8 *source, u32 size, std::vector<u8> &destination) {
+        size_t start = destination.size();
+
+        u32 anchor = 0;
+
+        if (size > match_limit) {
+            std::vector<u32> table(1u << hash_bits, 0xffffffffu);
+
+            u32 position = 0;
+            u32 limit = size - match_limit;
+
+            while (position < limit) {
+                u32 sequence = read_u32(source + position);
+                u32 &slot = table[hash(sequence)];
+                u32 candidate = slot;
+                slot = position;
+
+                if (candidate == 0xffffffffu || position - candidate > max_offset || read_u32(source + candidate) != sequence) {
+                    ++position;
+                    continue;
+                }
+
+                u32 length = min_match;
+                while (position + length < size - last_literals && source[candidate + length] == source[position + length])
+                    ++length;
+
+                write_sequence(destination, source + anchor, position - anchor, position - candidate, length);
+
+                position += length;
+                anchor = position;
+            }
+        }
+
+        write_sequence(destination, source + anchor, size - anchor, 0, 0);
+
+        return destination.size() - start;
+    }
+
+    void decompress_block(const u8 *source, u32 size, u8 *destination, u32 capacity) {
+        const u8 *input = source, *input_end = source + size;
+        u8 *output = destination, *output_end = destination + capacity;
+
+        while (input < input_end) {
+            u8 token = *input++;
+
+            u32 literal_length = read_length(input, input_end, token >> 4);
+            if (literal_length > static_cast<u64>(input_end - input) || literal_length > static_cast<u64>(output_end - output))
+                throw Exceptions::misbehavior("corrupted lz4 block");
+
+            std::memcpy(output, input, literal_length);
+            input += literal_length, output += literal_length;
+
+            if (input >= input_end)
+                break;
+
+            if (input_end - input < 2)
+                throw Exceptions::misbehavior("truncated lz4 block");
+
+            u32 offset = input[0] | (static_cast<u32>(input[1]) << 8);
+            input += 2;
+
+            u32 match_length = read_length(input, input_end, token & 0x0f) + min_match;
+
+            if (!offset || offset > static_cast<u64>(output - destination) || match_length > static_cast<u64>(output_end - output))
+                throw Exceptions::misbehavior("corrupted lz4 block");
+
+            const u8 *match = output - offset;
+
+            // overlapping matches repeat the pattern byte by byte
+            if (offset >= match_length) {
+                std::memcpy(output, match, match_length);
+                output += match_length;
+            } else {
+                for (u32 i = 0; i < match_length; ++i)
+                    *output++ = *match++;
+            }
+        }
+
+        if (output != output_end)
+            throw Exceptions::misbehavior("lz4 block size mismatch");
+    }
+
+    UNIFIED_NODISCARD bool read_header(const u8 *data, u64 size, Description &description) {
+        container_header header;
+        if (!read_container(data, size, header))
+            return false;
+
+        description.width = header.width;
+        description.height = header.height;
+        description.format = static_cast<Texture::Format>(header.format);
+
+        return true;
+    }
+
+    void decode(const u8 *data, u64 size, u8 *pixels, bool flip) {
+        container_header header;
+        if (!read_container(data, size, header))
+            throw Exceptions::misbehavior("bad lz4 pixel container");
+
+        u64 row_size = static_cast<u64>(header.width) * Texture::get_pixel_size(static_cast<Texture::Format>(header.format));
+        u64 total = row_size * header.height;
+
+        const u8 *input = data + sizeof(header), *input_end = data + size;
+        u8 *output = pixels;
+
+        for (u32 block = 0; block < header.block_count; ++block) {
+            if (input_end - input < 4)
+                throw Exceptions::misbehavior("truncated lz4 pixel container");
+
+            u32 compressed = read_u32(input);
+            input += 4;
+
+            u64 remaining = total - static_cast<u64>(output - pixels);
+            u32 expected = static_cast<u32>(std::min<u64>(header.block_size, remaining));
+
+            if (compressed > static_cast<u64>(input_end - input) || !expected)
+                throw Exceptions::misbehavior("truncated lz4 pixel container");
+
+            decompress_block(input, compressed, output, expected);
+            input += compressed, output += expected;
+        }
+
+        if (static_cast<u64>(output - pixels) != total)
+            throw Exceptions::misbehavior("lz4 pixel container size mismatch");
+
+        if (flip) {
+            std::vector<u8> row(static_cast<size_t>(row_size));
+            for (u32 y = 0; y < header.height / 2; ++y) {
+                u8 *top = pixels + y * row_size, *bottom = pixels + (header.height - 1 - y) * row_size;
+                std::memcpy(row.data(), top, row.size());
+                std::memcpy(top, bottom, row.size());
+                std::memcpy(bottom, row.data(), row.size());
+            }
+        }
+    }
+
+    UNIFIED_NODISCARD std::vector<u8> encode(const u8 *pixels, const Description &description) {
+        if (!pixels || !description.width || !description.height)
+            throw Exceptions::misbehavior("bad lz4 pixel description");
+
+        u64 total = static_cast<u64>(description.width) * description.height * Texture::get_pixel_size(description.format);
+        u32 block_count = static_cast<u32>((total + block_size - 1) / block_size);
+
+        container_header header { { 'U', 'L', 'Z', '4' }, container_version, description.width, description.height,
+            static_cast<u32>(description.format), block_size, block_count };
+
+        std::vector<u8> out(sizeof(header));
+        std::memcpy(out.data(), &header, sizeof(header));
+
+        for (u64 offset = 0; offset < total; offset += block_size) {
+            size_t size_position = out.size();
+            out.resize(size_position + 4);
+
+            auto compressed = static_cast<u32>(compress_block(pixels + offset, static_cast<u32>(std::min<u64>(block_size, total - offset)), out));
+            std::memcpy(out.data() + size_position, &compressed, sizeof(compressed));
+        }
+
+        return out;
+    }
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
@@ -0,0 +1,259 @@
+#include <unified/graphics/image/qoi.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <cstring>
+
+namespace
+{
+    using UNIFIED_NAMESPACE::u8;
+    using UNIFIED_NAMESPACE::u32;
+    using UNIFIED_NAMESPACE::u64;
+
+    UNIFIED_CONSTEXPR u8 op_index = 0x00;
+    UNIFIED_CONSTEXPR u8 op_diff  = 0x40;
+    UNIFIED_CONSTEXPR u8 op_luma  = 0x80;
+    UNIFIED_CONSTEXPR u8 op_run   = 0xc0;
+    UNIFIED_CONSTEXPR u8 op_rgb   = 0xfe;
+    UNIFIED_CONSTEXPR u8 op_rgba  = 0xff;
+    UNIFIED_CONSTEXPR u8 op_mask  = 0xc0;
+
+    UNIFIED_CONSTEXPR u64 header_size = 14;
+    UNIFIED_CONSTEXPR u8 end_marker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+    using pixel = UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Qoi::Pixel;
+
+    UNIFIED_FORCE_INLINE bool operator==(const pixel &left, const pixel &right) {
+        return left.r == right.r && left.g == right.g && left.b == right.b && left.a == right.a;
+    }
+
+    // the largest op, rgba, is five bytes
+    UNIFIED_CONSTEXPR u64 max_op_size = 5;
+    UNIFIED_CONSTEXPR u64 stream_chunk = 64 * 1024;
+
+    UNIFIED_FORCE_INLINE u32 hash(const pixel &px) {
+        return (px.r * 3u + px.g * 5u + px.b * 7u + px.a * 11u) % 64u;
+    }
+
+    UNIFIED_FORCE_INLINE u32 read_u32(const u8 *data) {
+        return (static_cast<u32>(data[0]) << 24) | (static_cast<u32>(data[1]) << 16) | (static_cast<u32>(data[2]) << 8) | data[3];
+    }
+
+    // applies one op to the running pixel, a run op only sets the count of repeats left
+    UNIFIED_FORCE_INLINE void read_op(const u8 *&input, pixel &px, pixel *index, u32 &run) {
+        u8 b1 = *input++;
+
+        if (b1 == op_rgb) {
+            px.r = input[0], px.g = input[1], px.b = input[2];
+            input += 3;
+        } else if (b1 == op_rgba) {
+            px.r = input[0], px.g = input[1], px.b = input[2], px.a = input[3];
+            input += 4;
+        } else switch (b1 & op_mask) {
+            case op_index:
+                px = index[b1];
+                break;
+
+            case op_diff:
+                px.r += ((b1 >> 4) & 0x03) - 2;
+                px.g += ((b1 >> 2) & 0x03) - 2;
+                px.b += (b1 & 0x03) - 2;
+                break;
+
+            case op_luma: {
+                u8 b2 = *input++;
+                int vg = (b1 & 0x3f) - 32;
+                px.r += vg - 8 + ((b2 >> 4) & 0x0f);
+                px.g += vg;
+                px.b += vg - 8 + (b2 & 0x0f);
+                break;
+            }
+
+            default:
+                run = b1 & 0x3f;
+                break;
+        }
+
+        index[hash(px)] = px;
+    }
+
+    void write_u32(std::vector<u8> &out, u32 value) {
+        out.push_back(static_cast<u8>(value >> 24));
+        out.push_back(static_cast<u8>(value >> 16));
+        out.push_back(static_cast<u8>(value >> 8));
+        out.push_back(static_cast<u8>(value));
+    }
+}
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+namespace Qoi
+{
+    UNIFIED_NODISCARD bool read_header(const u8 *data, u64 size, Description &description) {
+        if (!data || size < header_size || std::memcmp(data, "qoif", 4) != 0)
+            return false;
+
+        description.width = read_u32(data + 4);
+        description.height = read_u32(data + 8);
+        description.channels = data[12];
+        description.colorspace = data[13];
+
+        return description.width && description.height && (description.channels == 3 || description.channels == 4);
+    }
+
+    void decode(const u8 *data, u64 size, u8 *pixels, bool flip) {
+        Description description;
+        if (!read_header(data, size, description))
+            throw Exceptions::misbehavior("bad qoi header");
+
+        pixel index[64] = { };
+        pixel px = { 0, 0, 0, 255 };
+
+        u32 channels = description.channels;
+        u64 row_size = static_cast<u64>(description.width) * channels;
+
+        const u8 *input = data + header_size;
+        const u8 *input_end = data + size - sizeof(end_marker);
+
+        u32 run = 0;
+
+        for (u32 y = 0; y < description.height; ++y) {
+            u8 *output = pixels + (flip ? description.height - 1 - y : y) * row_size;
+
+            for (u32 x = 0; x < description.width; ++x, output += channels) {
+                if (run > 0) {
+                    --run;
+                } else {
+                    if (input >= input_end)
+                        throw Exceptions::misbehavior("truncated qoi stream");
+
+                    read_op(input, px, index, run);
+                }
+
+                output[0] = px.r, output[1] = px.g, output[2] = px.b;
+                if (channels == 4)
+                    output[3] = px.a;
+            }
+        }
+    }
+
+    UNIFIED_NODISCARD std::vector<u8> encode(const u8 *pixels, const Description &description) {
+        if (!pixels || !description.width || !description.height || (description.channels != 3 && description.channels != 4))
+            throw Exceptions::misbehavior("bad qoi description");
+
+        std::vector<u8> out;
+        u64 count = static_cast<u64>(description.width) * description.height;
+        out.reserve(static_cast<size_t>(header_size + count * (description.channels + 1) + sizeof(end_marker)));
+
+        out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+        write_u32(out, description.width);
+        write_u32(out, description.height);
+        out.push_back(description.channels);
+        out.push_back(description.colorspace);
+
+        pixel index[64] = { };
+        pixel previous = { 0, 0, 0, 255 };
+        u32 run = 0;
+
+        for (u64 i = 0; i < count; ++i) {
+            const u8 *input = pixels + i * description.channels;
+            pixel px = { input[0], input[1], input[2], description.channels == 4 ? input[3] : static_cast<u8>(255) };
+
+            if (px == previous) {
+                if (++run == 62 || i + 1 == count)
+                    out.push_back(static_cast<u8>(op_run | (run - 1))), run = 0;
+                continue;
+            }
+
+            if (run > 0)
+                out.push_back(static_cast<u8>(op_run | (run - 1))), run = 0;
+
+            u32 position = hash(px);
+
+            if (index[position] == px) {
+                out.push_back(static_cast<u8>(op_index | position));
+            } else {
+                index[position] = px;
+
+                if (px.a == previous.a) {
+                    signed char vr = static_cast<signed char>(px.r - previous.r);
+                    signed char vg = static_cast<signed char>(px.g - previous.g);
+                    signed char vb = static_cast<signed char>(px.b - previous.b);
+
+                    signed char vg_r = static_cast<signed char>(vr - vg);
+                    signed char vg_b = static_cast<signed char>(vb - vg);
+
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                        out.push_back(static_cast<u8>(op_diff | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+                    } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                        out.push_back(static_cast<u8>(op_luma | (vg + 32)));
+                        out.push_back(static_cast<u8>((vg_r + 8) << 4 | (vg_b + 8)));
+                    } else {
+                        out.insert(out.end(), { op_rgb, px.r, px.g, px.b });
+                    }
+                } else {
+                    out.insert(out.end(), { op_rgba, px.r, px.g, px.b, px.a });
+                }
+            }
+
+            previous = px;
+        }
+
+        out.insert(out.end(), end_marker, end_marker + sizeof(end_marker));
+        return out;
+    }
+
+    Decoder::Decoder(std::istream &input)
+        : _input(input), _description(), _buffer(stream_chunk + max_op_size), _position(0), _end(0), _index(), _pixel { 0, 0, 0, 255 }, _run(0), _row(0) {
+        u8 header[header_size];
+        if (!_input.read(reinterpret_cast<char*>(header), header_size) || !read_header(header, header_size, _description))
+            throw Exceptions::misbehavior("bad qoi header");
+    }
+
+    UNIFIED_NODISCARD const Description &Decoder::get_description() const {
+        return _description;
+    }
+
+    void Decoder::read_row(u8 *pixels) {
+        if (_row++ >= _description.height)
+            throw Exceptions::misbehavior("qoi stream has no rows left");
+
+        const u32 channels = _description.channels;
+
+        for (u32 x = 0; x < _description.width; ++x, pixels += channels) {
+            if (_run > 0) {
+                --_run;
+            } else {
+                if (_end - _position < max_op_size)
+                    refill();
+                if (_position >= _end)
+                    throw Exceptions::misbehavior("truncated qoi stream");
+
+                const u8 *input = _buffer.data() + _position;
+                read_op(input, _pixel, _index, _run);
+                _position = static_cast<u64>(input - _buffer.data());
+
+                if (_position > _end)
+                    throw Exceptions::misbehavior("truncated qoi stream");
+            }
+
+            pixels[0] = _pixel.r, pixels[1] = _pixel.g, pixels[2] = _pixel.b;
+            if (channels == 4)
+                pixels[3] = _pixel.a;
+        }
+    }
+
+    void Decoder::refill() {
+        // the unread tail moves to the front so an op never straddles two reads
+        const u64 left = _end - _position;
+        std::memmove(_buffer.data(), _buffer.data() + _position, static_cast<size_t>(left));
+
+        _input.read(reinterpret_cast<char*>(_buffer.data() + left), static_cast<std::streamsize>(stream_chunk));
+
+        _position = 0;
+        _end = left + static_cast<u64>(_input.gcount());
+    }
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
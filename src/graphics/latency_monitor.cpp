@@ -0,0 +1,150 @@
+#include <unified/graphics/latency_monitor.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+namespace {
+
+    UNIFIED_CONSTEXPR Timestamp no_input = 0;
+
+}
+
+LatencyMonitor::LatencyMonitor()
+    : _pending_input(no_input), _frames(), _first(0), _count(0), _initialized(false),
+      _histogram(bucket_count, 0), _latest(), _samples(0), _dropped(0) { }
+
+LatencyMonitor::~LatencyMonitor() {
+    if (!_initialized)
+        return;
+
+    for (u32 i = 0; i < _count; ++i)
+        glDeleteSync(static_cast<GLsync>(_frames[(_first + i) % frames_in_flight].fence));
+
+    for (Frame &frame : _frames)
+        glDeleteQueries(1, &frame.query);
+}
+
+void LatencyMonitor::consume(Timestamp input) {
+    if (input != no_input && (_pending_input == no_input || input < _pending_input))
+        _pending_input = input;
+}
+
+Timestamp LatencyMonitor::begin_frame() {
+    const Timestamp input = _pending_input;
+    _pending_input = no_input;
+    return input;
+}
+
+void LatencyMonitor::end_frame(Timestamp input) {
+    if (!_initialized) {
+        for (Frame &frame : _frames)
+            glGenQueries(1, &frame.query);
+        _initialized = true;
+    }
+
+    collect();
+
+    if (input == no_input)
+        return;
+
+    if (_count == frames_in_flight) {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++_dropped;
+        return;
+    }
+
+    // the timer query records when the GPU reached this point, the fence tells when the result can be read without stalling
+    Frame &frame = _frames[(_first + _count++) % frames_in_flight];
+    frame.input = input;
+    glQueryCounter(frame.query, GL_TIMESTAMP);
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+}
+
+UNIFIED_NODISCARD Time LatencyMonitor::get_percentile(double percentile) const {
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (!_samples)
+        return Time();
+
+    const u64 rank = static_cast<u64>(std::min(std::max(percentile, 0.0), 1.0) * static_cast<double>(_samples - 1));
+
+    u64 seen = 0;
+    for (u32 i = 0; i < bucket_count; ++i)
+        if ((seen += _histogram[i]) > rank)
+            return get_bucket_width() * static_cast<s64>(i + 1);
+    return get_bucket_width() * static_cast<s64>(bucket_count);
+}
+
+UNIFIED_NODISCARD Time LatencyMonitor::get_latest() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _latest;
+}
+
+UNIFIED_NODISCARD u64 LatencyMonitor::get_sample_count() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _samples;
+}
+
+UNIFIED_NODISCARD u64 LatencyMonitor::get_dropped_count() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _dropped;
+}
+
+UNIFIED_NODISCARD Time LatencyMonitor::get_bucket_width() {
+    return microseconds(100);
+}
+
+void LatencyMonitor::reset() {
+    std::lock_guard<std::mutex> guard(_lock);
+    std::fill(_histogram.begin(), _histogram.end(), 0);
+    _latest = Time();
+    _samples = 0;
+    _dropped = 0;
+}
+
+void LatencyMonitor::collect() {
+    while (_count) {
+        Frame &frame = _frames[_first];
+        GLsync fence = static_cast<GLsync>(frame.fence);
+
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+            break;
+
+        glDeleteSync(fence);
+        _first = (_first + 1) % frames_in_flight;
+        --_count;
+
+        if (status == GL_WAIT_FAILED)
+            continue;
+
+        // both clocks are sampled together so the GPU timestamp can be moved onto the CPU timeline
+        GLint64 gpu_now = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+        const Timestamp cpu_now = get_timestamp();
+
+        GLuint64 gpu_done = 0;
+        glGetQueryObjectui64v(frame.query, GL_QUERY_RESULT, &gpu_done);
+
+        const Time since_done = nanoseconds(gpu_now - static_cast<s64>(gpu_done));
+        add_sample(timestamp_to_time(cpu_now - frame.input) - since_done);
+    }
+}
+
+void LatencyMonitor::add_sample(Time latency) {
+    std::lock_guard<std::mutex> guard(_lock);
+
+    _latest = latency > Time() ? latency : Time();
+
+    const s64 bucket = _latest.asNanoseconds() / get_bucket_width().asNanoseconds();
+    ++_histogram[static_cast<u32>(std::min<s64>(bucket, bucket_count - 1))];
+    ++_samples;
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
@@ -1,11 +1,12 @@
 #include <unified/graphics/render_target.hpp>
+#include <unified/graphics/texture_residency.hpp>
 #include <unified/core/exceptions.hpp>
 #include <glad/glad.h>
 
 UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
 
-RenderTarget::RenderTarget() {
+RenderTarget::RenderTarget() : _commands(nullptr) {
     if (!gladLoadGL())
         throw Exceptions::initialization_failed("failed to initialize glad");
 
@@ -14,12 +15,34 @@ RenderTarget::RenderTarget() {
 }
 
 void RenderTarget::clear(const Color &color) {
+    if (_commands)
+        return _commands->clear(color);
+
     glClearColor(color.r, color.g, color.b, color.a);
     glClear(GL_COLOR_BUFFER_BIT);
 }
 
 void RenderTarget::draw(const Drawable &object, const Shader *shader) const {
+    if (_commands)
+        return _commands->draw(object, shader);
+
     object.draw(*this, shader);
+    TextureResidency::next_draw();
+}
+
+void RenderTarget::invoke(std::function<void()> function) const {
+    if (_commands)
+        return _commands->invoke(std::move(function));
+
+    function();
+}
+
+UNIFIED_NODISCARD CommandList *RenderTarget::get_command_list() const {
+    return _commands;
+}
+
+void RenderTarget::set_command_list(CommandList *commands) {
+    _commands = commands;
 }
 
 UNIFIED_GRAPHICS_END_NAMESPACE
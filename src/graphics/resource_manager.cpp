@@ -0,0 +1,265 @@
+#include <unified/graphics/resource_manager.hpp>
+#include <unified/core/exceptions.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+ResourceManager *ResourceManager::current = 0;
+
+ResourceManager::ResourceManager(u32 block_size)
+    : _mutex(), _slots(), _free_slots(), _live_count(0), _pools(), _pending(), _unresolved(), _demand(), _doomed(), _generated(),
+      _block_size(block_size), _gl_thread(std::this_thread::get_id()) {
+    if (!block_size)
+        throw Exceptions::misbehavior("bad resource block size");
+}
+
+ResourceManager::~ResourceManager() {
+    if (current == this)
+        current = 0;
+
+    process();
+
+    for (u32 type = 0; type < type_count; ++type)
+        if (!_pools[type].empty())
+            remove(static_cast<Type>(type), static_cast<u32>(_pools[type].size()), _pools[type].data());
+}
+
+ResourceManager::Handle ResourceManager::create(Type type, u32 &name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<u32> &pool = _pools[static_cast<u32>(type)];
+    ++_demand[static_cast<u32>(type)];
+
+    const bool gl_thread = std::this_thread::get_id() == _gl_thread;
+    if (pool.empty() && gl_thread) {
+        pool.resize(_block_size);
+        generate(type, _block_size, pool.data());
+    }
+
+    // a burst off the GL thread outran the pool, the name is filled in by the next process()
+    name = 0;
+    if (!pool.empty()) {
+        name = pool.back();
+        pool.pop_back();
+    }
+
+    u32 index;
+    if (_free_slots.empty()) {
+        index = static_cast<u32>(_slots.size());
+        _slots.push_back(Slot { 0, 1, type, false });
+    } else {
+        index = _free_slots.back();
+        _free_slots.pop_back();
+    }
+
+    Slot &slot = _slots[index];
+    slot.name = name;
+    slot.type = type;
+    slot.alive = true;
+    ++_live_count;
+
+    const Handle handle = (static_cast<Handle>(slot.generation) << 32) | index;
+    if (!name)
+        _unresolved.push_back(handle);
+    return handle;
+}
+
+void ResourceManager::destroy(Handle handle) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Slot *slot = const_cast<Slot*>(find(handle));
+    if (!slot)
+        return;
+
+    slot->alive = false;
+    --_live_count;
+    _pending.push_back(handle);
+}
+
+UNIFIED_NODISCARD u32 ResourceManager::resolve(Handle handle) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const Slot *slot = find(handle);
+    return slot ? slot->name : 0;
+}
+
+u32 ResourceManager::realize(Handle handle) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Slot *slot = const_cast<Slot*>(find(handle));
+    if (!slot)
+        return 0;
+
+    // process() skips handles that got their name here
+    if (!slot->name && std::this_thread::get_id() == _gl_thread)
+        generate(slot->type, 1, &slot->name);
+    return slot->name;
+}
+
+UNIFIED_NODISCARD u32 ResourceManager::get_block_size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _block_size;
+}
+
+void ResourceManager::set_block_size(u32 block_size) {
+    if (!block_size)
+        throw Exceptions::misbehavior("bad resource block size");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _block_size = block_size;
+}
+
+void ResourceManager::process() {
+    u32 missing[type_count];
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _gl_thread = std::this_thread::get_id();
+
+        for (Handle handle : _pending) {
+            const u32 index = static_cast<u32>(handle);
+            Slot &slot = _slots[index];
+
+            if (slot.name)
+                _doomed[static_cast<u32>(slot.type)].push_back(slot.name);
+
+            slot.name = 0;
+            if (!++slot.generation)
+                slot.generation = 1;
+            _free_slots.push_back(index);
+        }
+        _pending.clear();
+
+        // one batch per type. handles destroyed before they got a name went through the loop above and
+        // no longer resolve
+        for (u32 type = 0; type < type_count && !_unresolved.empty(); ++type) {
+            _generated.clear();
+            for (Handle handle : _unresolved) {
+                const Slot *slot = find(handle);
+                if (slot && !slot->name && static_cast<u32>(slot->type) == type)
+                    _generated.push_back(0);
+            }
+            if (_generated.empty())
+                continue;
+
+            generate(static_cast<Type>(type), static_cast<u32>(_generated.size()), _generated.data());
+
+            u32 next = 0;
+            for (Handle handle : _unresolved) {
+                Slot *slot = const_cast<Slot*>(find(handle));
+                if (slot && !slot->name && static_cast<u32>(slot->type) == type)
+                    slot->name = _generated[next++];
+            }
+        }
+        _unresolved.clear();
+
+        // a pool is topped up once it is half empty, so name generation stays in blocks. the block
+        // grows to whatever the last frame created, so the same burst next frame is served from the pool
+        for (u32 type = 0; type < type_count; ++type) {
+            const u32 target = std::max(_block_size, _demand[type]);
+            const u32 size = static_cast<u32>(_pools[type].size());
+            missing[type] = size * 2 <= target ? target - size : 0;
+            _demand[type] = 0;
+        }
+    }
+
+    for (u32 type = 0; type < type_count; ++type) {
+        if (!_doomed[type].empty()) {
+            remove(static_cast<Type>(type), static_cast<u32>(_doomed[type].size()), _doomed[type].data());
+            _doomed[type].clear();
+        }
+
+        if (!missing[type])
+            continue;
+
+        _generated.resize(missing[type]);
+        generate(static_cast<Type>(type), missing[type], _generated.data());
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pools[type].insert(_pools[type].end(), _generated.begin(), _generated.end());
+    }
+}
+
+UNIFIED_NODISCARD u32 ResourceManager::get_live_count() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _live_count;
+}
+
+UNIFIED_NODISCARD u32 ResourceManager::get_pending_count() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<u32>(_pending.size());
+}
+
+UNIFIED_NODISCARD u32 ResourceManager::get_pooled_count(Type type) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<u32>(_pools[static_cast<u32>(type)].size());
+}
+
+u32 ResourceManager::acquire(Type type, Handle &handle) {
+    u32 name = 0;
+
+    if (current) {
+        handle = current->create(type, name);
+        return name;
+    }
+
+    handle = 0;
+    generate(type, 1, &name);
+    return name;
+}
+
+void ResourceManager::release(Type type, Handle handle, u32 name) {
+    if (handle && current)
+        current->destroy(handle);
+    else if (name)
+        remove(type, 1, &name);
+}
+
+UNIFIED_NODISCARD const ResourceManager::Slot *ResourceManager::find(Handle handle) const {
+    const u32 index = static_cast<u32>(handle);
+    if (index >= _slots.size())
+        return nullptr;
+
+    const Slot &slot = _slots[index];
+    return slot.alive && slot.generation == static_cast<u32>(handle >> 32) ? &slot : nullptr;
+}
+
+void ResourceManager::generate(Type type, u32 count, u32 *names) {
+    switch (type) {
+        case Type::Buffer:
+            glGenBuffers(static_cast<GLsizei>(count), names);
+            break;
+        case Type::Texture:
+            glGenTextures(static_cast<GLsizei>(count), names);
+            break;
+        case Type::Program:
+            for (u32 i = 0; i < count; ++i)
+                names[i] = glCreateProgram();
+            break;
+    }
+
+    for (u32 i = 0; i < count; ++i)
+        if (!names[i])
+            throw Exceptions::initialization_failed("failed to generate GL object names");
+}
+
+void ResourceManager::remove(Type type, u32 count, const u32 *names) {
+    switch (type) {
+        case Type::Buffer:
+            glDeleteBuffers(static_cast<GLsizei>(count), names);
+            break;
+        case Type::Texture:
+            glDeleteTextures(static_cast<GLsizei>(count), names);
+            break;
+        case Type::Program:
+            for (u32 i = 0; i < count; ++i)
+                glDeleteProgram(names[i]);
+            break;
+    }
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
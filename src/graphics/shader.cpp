@@ -1,4 +1,5 @@
 #include <unified/graphics/shader.hpp>
+#include <unified/graphics/context_owner.hpp>
 #include <unified/core/exceptions.hpp>
 
 #include <unified/core/math/matrix.hpp>
@@ -11,9 +12,9 @@
 UNIFIED_BEGIN_NAMESPACE
 UNIFIED_GRAPHICS_BEGIN_NAMESPACE
 
-Shader::Shader() : _id(0) { }
+Shader::Shader() : _id(0), _resource(0) { }
 
-Shader::Shader(const char *vertex_shader, const char *fragment_shader) {
+Shader::Shader(const char *vertex_shader, const char *fragment_shader) : _id(0), _resource(0) {
     compile(vertex_shader, fragment_shader);
 }
 
@@ -33,122 +34,124 @@ UNIFIED_NODISCARD Shader::HandleType Shader::handle() const {
 }
 
 void Shader::set_int(const char *name, int value) {
-    glUniform1i(glGetUniformLocation(_id, name), value);
+    glUniform1i(location(name), value);
 }
 
 void Shader::set_int2(const char *name, const int *value) {
-    glUniform2i(glGetUniformLocation(_id, name), value[0], value[1]);
+    glUniform2i(location(name), value[0], value[1]);
 }
 
 void Shader::set_int3(const char *name, const int *value) {
-    glUniform3i(glGetUniformLocation(_id, name), value[0], value[1], value[2]);
+    glUniform3i(location(name), value[0], value[1], value[2]);
 }
 
 void Shader::set_int4(const char *name, const int *value) {
-    glUniform4i(glGetUniformLocation(_id, name), value[0], value[1], value[2], value[3]);
+    glUniform4i(location(name), value[0], value[1], value[2], value[3]);
 }
 
 void Shader::set_int2(const char *name, const Point<int, 2> &value) {
-    glUniform2i(glGetUniformLocation(_id, name), value.x, value.y);
+    glUniform2i(location(name), value.x, value.y);
 }
 
 void Shader::set_int3(const char *name, const Point<int, 3> &value) {
-    glUniform3i(glGetUniformLocation(_id, name), value.x, value.y, value.z);
+    glUniform3i(location(name), value.x, value.y, value.z);
 }
 
 void Shader::set_int4(const char *name, const Point<int, 4> &value) {
-    glUniform4i(glGetUniformLocation(_id, name), value.x, value.y, value.z, value.w);
+    glUniform4i(location(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::set_float(const char *name, float value) {
-    glUniform1f(glGetUniformLocation(_id, name), value);
+    glUniform1f(location(name), value);
 }
 
 void Shader::set_float2(const char *name, const float *value) {
-    glUniform2f(glGetUniformLocation(_id, name), value[0], value[1]);
+    glUniform2f(location(name), value[0], value[1]);
 }
 
 void Shader::set_float3(const char *name, const float *value) {
-    glUniform3f(glGetUniformLocation(_id, name), value[0], value[1], value[2]);
+    glUniform3f(location(name), value[0], value[1], value[2]);
 }
 
 void Shader::set_float4(const char *name, const float *value) {
-    glUniform4f(glGetUniformLocation(_id, name), value[0], value[1], value[2], value[3]);
+    glUniform4f(location(name), value[0], value[1], value[2], value[3]);
 }
 
 void Shader::set_float2(const char *name, const Point<float, 2> &value) {
-    glUniform2f(glGetUniformLocation(_id, name), value.x, value.y);
+    glUniform2f(location(name), value.x, value.y);
 }
 
 void Shader::set_float3(const char *name, const Point<float, 3> &value) {
-    glUniform3f(glGetUniformLocation(_id, name), value.x, value.y, value.z);
+    glUniform3f(location(name), value.x, value.y, value.z);
 }
 
 void Shader::set_float4(const char *name, const Point<float, 4> &value) {
-    glUniform4f(glGetUniformLocation(_id, name), value.x, value.y, value.z, value.w);
+    glUniform4f(location(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::set_double(const char *name, double value) {
-    glUniform1d(glGetUniformLocation(_id, name), value);
+    glUniform1d(location(name), value);
 }
 
 void Shader::set_double2(const char *name, const double *value) {
-    glUniform2d(glGetUniformLocation(_id, name), value[0], value[1]);
+    glUniform2d(location(name), value[0], value[1]);
 }
 
 void Shader::set_double3(const char *name, const double *value) {
-    glUniform3d(glGetUniformLocation(_id, name), value[0], value[1], value[2]);
+    glUniform3d(location(name), value[0], value[1], value[2]);
 }
 
 void Shader::set_double4(const char *name, const double *value) {
-    glUniform4d(glGetUniformLocation(_id, name), value[0], value[1], value[2], value[3]);
+    glUniform4d(location(name), value[0], value[1], value[2], value[3]);
 }
 
 void Shader::set_double2(const char *name, const Point<double, 2> &value) {
-    glUniform2d(glGetUniformLocation(_id, name), value.x, value.y);
+    glUniform2d(location(name), value.x, value.y);
 }
 
 void Shader::set_double3(const char *name, const Point<double, 3> &value) {
-    glUniform3d(glGetUniformLocation(_id, name), value.x, value.y, value.z);
+    glUniform3d(location(name), value.x, value.y, value.z);
 }
 
 void Shader::set_double4(const char *name, const Point<double, 4> &value) {
-    glUniform4d(glGetUniformLocation(_id, name), value.x, value.y, value.z, value.w);
+    glUniform4d(location(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::set_float3x3(const char *name, float *value) {
-    glUniformMatrix3fv(glGetUniformLocation(_id, name), 1, GL_FALSE, value);
+    glUniformMatrix3fv(location(name), 1, GL_FALSE, value);
 }
 
 void Shader::set_float4x4(const char *name, float *value) {
-    glUniformMatrix4fv(glGetUniformLocation(_id, name), 1, GL_FALSE, value);
+    glUniformMatrix4fv(location(name), 1, GL_FALSE, value);
 }
 
 void Shader::set_float3x3(const char *name, const Matrix<float, 3, 3> &value) {
-    glUniformMatrix3fv(glGetUniformLocation(_id, name), 1, GL_FALSE, value.data());
+    glUniformMatrix3fv(location(name), 1, GL_FALSE, value.data());
 }
 
 void Shader::set_float4x4(const char *name, const Matrix<float, 4, 4> &value) {
-    glUniformMatrix4fv(glGetUniformLocation(_id, name), 1, GL_FALSE, value.data());
+    glUniformMatrix4fv(location(name), 1, GL_FALSE, value.data());
 }
 
 void Shader::set_double3x3(const char *name, const double *value) {
-    glUniformMatrix3dv(glGetUniformLocation(_id, name), 1, GL_FALSE, value);
+    glUniformMatrix3dv(location(name), 1, GL_FALSE, value);
 }
 
 void Shader::set_double4x4(const char *name, const double *value) {
-    glUniformMatrix4dv(glGetUniformLocation(_id, name), 1, GL_FALSE, value);
+    glUniformMatrix4dv(location(name), 1, GL_FALSE, value);
 }
 
 void Shader::set_double3x3(const char *name, const Matrix<double, 3, 3> &value) {
-    glUniformMatrix3dv(glGetUniformLocation(_id, name), 1, GL_FALSE, value.data());
+    glUniformMatrix3dv(location(name), 1, GL_FALSE, value.data());
 }
 
 void Shader::set_double4x4(const char *name, const Matrix<double, 4, 4> &value) {
-    glUniformMatrix4dv(glGetUniformLocation(_id, name), 1, GL_FALSE, value.data());
+    glUniformMatrix4dv(location(name), 1, GL_FALSE, value.data());
 }
 
 void Shader::compile(const char *vertex_shader, const char *fragment_shader) {
+    ContextOwner::check();
+
     GLuint vertex_shader_id = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertex_shader_id, 1, &vertex_shader, 0);
     glCompileShader(vertex_shader_id);
@@ -159,15 +162,22 @@ void Shader::compile(const char *vertex_shader, const char *fragment_shader) {
     glCompileShader(fragment_shader_id);
     throw_if_error(fragment_shader_id, GL_COMPILE_STATUS);
 
-    _id = glCreateProgram();
+    _id = ResourceManager::acquire(ResourceManager::Type::Program, _resource);
     glAttachShader(_id, vertex_shader_id);
     glAttachShader(_id, fragment_shader_id);
     glLinkProgram(_id);
     throw_if_error(_id, GL_LINK_STATUS);
 }
 
+s32 Shader::location(const char *name) const {
+    ContextOwner::check();
+    return glGetUniformLocation(_id, name);
+}
+
 void Shader::free()  {
-    glDeleteProgram(_id);
+    ResourceManager::release(ResourceManager::Type::Program, _resource, _id);
+    _id = 0;
+    _resource = 0;
 }
 
 void Shader::throw_if_error(u32 id, u32 type) {
@@ -211,16 +221,20 @@ void Shader::bind(const Shader *shader) {
     if (!shader)
         throw Exceptions::misbehavior("bad " UNIFIED_GRAPHICS_NAMESPACE_STRING "::Shader pointer");
 
+    ContextOwner::check();
     glUseProgram(shader->handle());
 }
 
 void Shader::unbind() {
+    ContextOwner::check();
     glUseProgram(0);
 }
 
 Shader *Shader::ScopeBind::current = 0;
 
 Shader::ScopeBind::ScopeBind(const Shader *shader) {
+    ContextOwner::check();
+
     if (current && (current->handle() == shader->handle())) {
         _prev = 0;
         return;
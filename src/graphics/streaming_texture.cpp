@@ -0,0 +1,152 @@
+#include <unified/graphics/streaming_texture.hpp>
+#include <unified/core/exceptions.hpp>
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+StreamingTexture::StreamingTexture(Point2i size, Format format, u32 tile_size)
+    : Texture(size, format), _pixel_buffer_index(0), _tile_size(tile_size), _uploaded_tiles(0) {
+    glGenBuffers(2, _pixel_buffers);
+    if (!_pixel_buffers[0] || !_pixel_buffers[1])
+        throw Exceptions::initialization_failed("failed to initialize the pixel unpack buffers");
+
+    if (_tile_size) {
+        _tiles = Point2i((_width + _tile_size - 1) / _tile_size, (_height + _tile_size - 1) / _tile_size);
+        _shadow.resize(static_cast<size_t>(_width) * _height * get_pixel_size());
+        _valid.assign(static_cast<size_t>(_tiles.x) * _tiles.y, false);
+    }
+}
+
+StreamingTexture::~StreamingTexture() {
+    glDeleteBuffers(2, _pixel_buffers);
+}
+
+void StreamingTexture::update(const void *pixels) {
+    update(Region(Point2i(0, 0), get_size()), pixels);
+}
+
+void StreamingTexture::update(const Region &region, const void *pixels) {
+    if (region.position.x < 0 || region.position.y < 0 || region.size.x <= 0 || region.size.y <= 0 ||
+        region.position.x + region.size.x > _width || region.position.y + region.size.y > _height)
+        throw Exceptions::misbehavior("bad " UNIFIED_GRAPHICS_NAMESPACE_STRING "::StreamingTexture region");
+
+    auto source = static_cast<const u8*>(pixels);
+
+    _spans.clear();
+    _uploaded_tiles = 0;
+
+    if (_tile_size) {
+        int tile_size = static_cast<int>(_tile_size);
+
+        Point2i first(region.position.x / tile_size, region.position.y / tile_size);
+        Point2i last((region.position.x + region.size.x - 1) / tile_size, (region.position.y + region.size.y - 1) / tile_size);
+
+        for (int y = first.y; y <= last.y; ++y)
+            for (int x = first.x; x <= last.x; ++x) {
+                Point2i position(std::max(x * tile_size, region.position.x), std::max(y * tile_size, region.position.y));
+                Point2i end(std::min((x + 1) * tile_size, region.position.x + region.size.x),
+                            std::min((y + 1) * tile_size, region.position.y + region.size.y));
+                Region tile(position, end - position);
+
+                if (!compare_tile(tile, region, source))
+                    continue;
+
+                ++_uploaded_tiles;
+
+                // neighbouring dirty tiles of one tile row are merged into a single upload
+                if (!_spans.empty() && _spans.back().position.y == tile.position.y &&
+                    _spans.back().position.x + _spans.back().size.x == tile.position.x)
+                    _spans.back().size.x += tile.size.x;
+                else
+                    _spans.push_back(tile);
+            }
+
+        if (_spans.empty())
+            return;
+    } else {
+        _spans.push_back(region);
+        _uploaded_tiles = 1;
+    }
+
+    // only the dirty spans travel, each packed at its own offset of the buffer
+    u32 pixel_size = get_pixel_size();
+    GLsizeiptr size = 0;
+    for (const auto &span : _spans)
+        size += static_cast<GLsizeiptr>(span.size.x) * span.size.y * pixel_size;
+
+    _pixel_buffer_index = (_pixel_buffer_index + 1) % 2;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixel_buffers[_pixel_buffer_index]);
+
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, 0, GL_STREAM_DRAW);
+    auto mapped = static_cast<u8*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        throw Exceptions::misbehavior("failed to map the pixel unpack buffer");
+    }
+
+    size_t offset = 0;
+    for (const auto &span : _spans) {
+        size_t row_size = static_cast<size_t>(span.size.x) * pixel_size;
+        for (int y = span.position.y; y < span.position.y + span.size.y; ++y, offset += row_size)
+            std::memcpy(mapped + offset, source + (static_cast<size_t>(y - region.position.y) * region.size.x +
+                (span.position.x - region.position.x)) * pixel_size, row_size);
+    }
+
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    offset = 0;
+    for (const auto &span : _spans) {
+        upload(span.position, span.size, reinterpret_cast<const void*>(offset), static_cast<u32>(span.size.x));
+        offset += static_cast<size_t>(span.size.x) * span.size.y * pixel_size;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+UNIFIED_NODISCARD u32 StreamingTexture::get_tile_size() const {
+    return _tile_size;
+}
+
+UNIFIED_NODISCARD u32 StreamingTexture::get_uploaded_tiles() const {
+    return _uploaded_tiles;
+}
+
+bool StreamingTexture::compare_tile(const Region &tile, const Region &region, const u8 *pixels) {
+    u32 pixel_size = get_pixel_size();
+    size_t row_size = static_cast<size_t>(tile.size.x) * pixel_size;
+
+    auto source_row = [&](int y) {
+        return pixels + (static_cast<size_t>(y - region.position.y) * region.size.x + (tile.position.x - region.position.x)) * pixel_size;
+    };
+
+    auto shadow_row = [&](int y) {
+        return _shadow.data() + (static_cast<size_t>(y) * _width + tile.position.x) * pixel_size;
+    };
+
+    size_t index = static_cast<size_t>(tile.position.y / _tile_size) * _tiles.x + tile.position.x / _tile_size;
+    bool dirty = !_valid[index];
+
+    for (int y = tile.position.y; !dirty && y < tile.position.y + tile.size.y; ++y)
+        dirty = std::memcmp(source_row(y), shadow_row(y), row_size) != 0;
+
+    if (!dirty)
+        return false;
+
+    for (int y = tile.position.y; y < tile.position.y + tile.size.y; ++y)
+        std::memcpy(shadow_row(y), source_row(y), row_size);
+
+    // a partially covered tile only holds known contents for the covered part
+    int tile_size = static_cast<int>(_tile_size);
+    _valid[index] = tile.size.x == std::min(tile_size, _width - (tile.position.x / tile_size) * tile_size) &&
+                    tile.size.y == std::min(tile_size, _height - (tile.position.y / tile_size) * tile_size);
+
+    return true;
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
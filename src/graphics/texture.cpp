@@ -1,83 +1,295 @@
 #include <unified/graphics/texture.hpp>
+#include <unified/graphics/texture_residency.hpp>
+#include <unified/graphics/context_owner.hpp>
+#include <unified/graphics/image/qoi.hpp>
+#include <unified/graphics/image/lz4.hpp>
 #include <unified/core/exceptions.hpp>
+#include <unified/core/memory/memory_tracker.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 
 #include <stb_image.h>
 #include <glad/glad.h>
 
-UNIFIED_BEGIN_NAMESPACE
-UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+#include <cstring>
+#include <fstream>
+#include <vector>
 
-Texture::Texture(string image, bool flip) {
-    stbi_set_flip_vertically_on_load(static_cast<int>(flip));
+namespace
+{
+    using UNIFIED_NAMESPACE::u8;
+    using UNIFIED_NAMESPACE::u32;
+    using UNIFIED_NAMESPACE::u64;
+    using Format = UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Texture::Format;
 
-    auto buffer = stbi_load(image.c_str(), &_width, &_height, &_channels, 4);
+    enum class Depth : u32
+    {
+        UnsignedByte,
+        UnsignedShort,
+        Float
+    };
 
-    if (!buffer)
-        throw Exceptions::misbehavior("failed to load image");
+    // binds a texture on unit 0 for the scope, then gives unit 0 its texture back and reactivates the
+    // unit that was active. a restore can run in the middle of binding other units for a draw
+    class ScopeUnit
+    {
+    public:
 
-    generate_texture(_id, 1, buffer);
+        explicit ScopeUnit(GLuint texture) : _active(0), _bound(0) {
+            glGetIntegerv(GL_ACTIVE_TEXTURE, &_active);
+            glActiveTexture(GL_TEXTURE0);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &_bound);
+            glBindTexture(GL_TEXTURE_2D, texture);
+        }
 
-    stbi_image_free(buffer);
-}
+        ~ScopeUnit() {
+            glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(_bound));
+            glActiveTexture(static_cast<GLenum>(_active));
+        }
 
-Texture::Texture(u8 *data, u32 size, bool flip) {
-    stbi_set_flip_vertically_on_load(static_cast<int>(flip));
+    protected:
 
-    auto buffer = stbi_load_from_memory(data, static_cast<int>(size), &_width, &_height, &_channels, 4);
+        GLint _active;
+        GLint _bound;
 
-    if (!buffer)
-        throw Exceptions::misbehavior("failed to load image");
+    };
+
+    struct format_description
+    {
+        GLint internal_format;
+        GLenum format;
+        GLenum type;
+    };
+
+    struct image_memory
+    {
+        const stbi_uc *data;
+        int size;
+
+        int is_hdr() const { return stbi_is_hdr_from_memory(data, size); }
+        int is_16_bit() const { return stbi_is_16_bit_from_memory(data, size); }
+
+        void *load(int *x, int *y, int *channels) const { return stbi_load_from_memory(data, size, x, y, channels, 0); }
+        void *load_16(int *x, int *y, int *channels) const { return stbi_load_16_from_memory(data, size, x, y, channels, 0); }
+        void *load_float(int *x, int *y, int *channels) const { return stbi_loadf_from_memory(data, size, x, y, channels, 0); }
+    };
+
+    void *load_image(const image_memory &image, int &width, int &height, int &channels, Format &format) {
+        void *buffer;
+        Depth depth;
+
+        if (image.is_hdr())
+            buffer = image.load_float(&width, &height, &channels), depth = Depth::Float;
+        else if (image.is_16_bit())
+            buffer = image.load_16(&width, &height, &channels), depth = Depth::UnsignedShort;
+        else
+            buffer = image.load(&width, &height, &channels), depth = Depth::UnsignedByte;
+
+        if (!buffer)
+            throw UNIFIED_NAMESPACE::Exceptions::misbehavior("failed to load image");
+
+        format = static_cast<Format>(static_cast<u32>(depth) * 4 + static_cast<u32>(channels - 1));
+        return buffer;
+    }
+
+    // the size and format load() would end up with, without decoding anything
+    bool describe_image(const u8 *data, u64 size, int &width, int &height, Format &format) {
+        UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Qoi::Description qoi;
+        UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Lz4::Description lz4;
+
+        if (UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Qoi::read_header(data, size, qoi)) {
+            width = static_cast<int>(qoi.width), height = static_cast<int>(qoi.height);
+            format = qoi.channels == 4 ? Format::RGBA8 : Format::RGB8;
+            return true;
+        }
+
+        if (UNIFIED_NAMESPACE::UNIFIED_GRAPHICS_NAMESPACE::Lz4::read_header(data, size, lz4)) {
+            width = static_cast<int>(lz4.width), height = static_cast<int>(lz4.height), format = lz4.format;
+            return true;
+        }
+
+        const image_memory image { data, static_cast<int>(size) };
+
+        int channels = 0;
+        if (!stbi_info_from_memory(image.data, image.size, &width, &height, &channels))
+            return false;
+
+        Depth depth = image.is_hdr() ? Depth::Float : image.is_16_bit() ? Depth::UnsignedShort : Depth::UnsignedByte;
+        format = static_cast<Format>(static_cast<u32>(depth) * 4 + static_cast<u32>(channels - 1));
+        return true;
+    }
+
+    std::vector<u8> read_file(const UNIFIED_NAMESPACE::string &path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw UNIFIED_NAMESPACE::Exceptions::misbehavior("failed to load image");
+
+        std::vector<u8> data(static_cast<size_t>(file.tellg()));
+        if (!file.seekg(0) || !file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+            throw UNIFIED_NAMESPACE::Exceptions::misbehavior("failed to load image");
+
+        return data;
+    }
+
+    struct unpack_buffer
+    {
+        GLuint id;
 
-    generate_texture(_id, 1, buffer);
+        unpack_buffer(u64 size) {
+            glGenBuffers(1, &id);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, id);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), 0, GL_STREAM_DRAW);
+        }
 
-    stbi_image_free(buffer);
+        ~unpack_buffer() {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &id);
+        }
+
+        u8 *map(u64 size, GLbitfield access) {
+            auto mapped = static_cast<u8*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size), access));
+            if (!mapped)
+                throw UNIFIED_NAMESPACE::Exceptions::misbehavior("failed to map the pixel unpack buffer");
+            return mapped;
+        }
+
+        void unmap() {
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+    };
+
+    format_description describe_format(Format format) {
+        static const GLint internal_formats[] = {
+            GL_R8,   GL_RG8,   GL_RGB8,   GL_RGBA8,
+            GL_R16,  GL_RG16,  GL_RGB16,  GL_RGBA16,
+            GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F
+        };
+        static const GLenum formats[] = { GL_RED, GL_RG, GL_RGB, GL_RGBA };
+        static const GLenum types[] = { GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_FLOAT };
+
+        u32 index = static_cast<u32>(format);
+        return { internal_formats[index], formats[index % 4], types[index / 4] };
+    }
+}
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+Texture::Texture(string image, bool flip) : _id(0), _resource(0), _source(image), _flip(flip), _residency(0), _gpu_size(0) {
+    MemoryTracker::ScopeTag tag(MemoryTag::Textures);
+    auto data = read_file(image);
+    load(data.data(), data.size());
+}
+
+Texture::Texture(u8 *data, u32 size, bool flip) : _id(0), _resource(0), _flip(flip), _residency(0), _gpu_size(0) {
+    MemoryTracker::ScopeTag tag(MemoryTag::Textures);
+    load(data, size);
+}
+
+Texture::Texture(Point2i size, Format format) : _id(0), _resource(0), _width(size.x), _height(size.y), _format(format), _flip(false), _residency(0), _gpu_size(0) {
+    MemoryTracker::ScopeTag tag(MemoryTag::Textures);
+    _channels = static_cast<int>(static_cast<u32>(format) % 4 + 1);
+    generate_texture(_id, 0);
 }
 
 Texture::~Texture() {
-    glDeleteTextures(1, &_id);
+    if (_residency)
+        _residency->release(this);
+    ResourceManager::release(ResourceManager::Type::Texture, _resource, _id);
+    MemoryTracker::record_gpu(MemoryTag::Textures, -static_cast<s64>(_gpu_size));
 }
 
 Texture::HandleType Texture::handle() const {
     return _id;
 }
 
+UNIFIED_NODISCARD Point2i Texture::get_size() const {
+    return Point2i(_width, _height);
+}
+
+UNIFIED_NODISCARD u32 Texture::get_channels() const {
+    return static_cast<u32>(_channels);
+}
+
+UNIFIED_NODISCARD Texture::Format Texture::get_format() const {
+    return _format;
+}
+
+UNIFIED_NODISCARD u32 Texture::get_pixel_size() const {
+    return get_pixel_size(_format);
+}
+
+UNIFIED_NODISCARD u32 Texture::get_pixel_size(Format format) {
+    static const u32 depth_sizes[] = { sizeof(GLubyte), sizeof(GLushort), sizeof(GLfloat) };
+    return (static_cast<u32>(format) % 4 + 1) * depth_sizes[static_cast<u32>(format) / 4];
+}
+
+UNIFIED_NODISCARD u64 Texture::get_memory_size() const {
+    static const u64 storage_sizes[] = { sizeof(GLubyte), sizeof(GLushort), sizeof(GLhalf) };
+    return static_cast<u64>(_width) * _height * _channels * storage_sizes[static_cast<u32>(_format) / 4];
+}
+
+void Texture::read(void *buffer) const {
+    ContextOwner::check();
+
+    // the residency reads a texture back while evicting it, which must not disturb the units of a draw
+    ScopeUnit unit(_id);
+
+    auto description = describe_format(_format);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, description.format, description.type, buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
 void Texture::bind(const Texture *texture, SlotType slot) {
     if (!texture)
         throw Exceptions::misbehavior("bad " UNIFIED_GRAPHICS_NAMESPACE_STRING "::Texture pointer");
 
+    ContextOwner::check();
+
+    if (texture->_residency)
+        texture->_residency->touch(texture);
+
     glActiveTexture(GL_TEXTURE0 + slot);
     glBindTexture(GL_TEXTURE_2D, texture->handle());
 }
 
 void Texture::unbind() {
+    ContextOwner::check();
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 Texture *Texture::ScopeBind::current = 0;
 
-Texture::ScopeBind::ScopeBind(const Texture *texture) {
+Texture::ScopeBind::ScopeBind(const Texture *texture) : _prev(0), _bound(false) {
+    ContextOwner::check();
+
     if (current && (current->handle() == texture->handle())) {
-        _prev = 0;
+        // already bound, but it is still a use the residency has to see
+        if (texture->_residency)
+            texture->_residency->touch(texture);
         return;
     }
 
     _prev = current;
-    current = const_cast<Texture*>(texture);;
+    current = const_cast<Texture*>(texture);
+    _bound = true;
 
     bind(texture);
 }
 
 Texture::ScopeBind::~ScopeBind() {
-    if (_prev) {
+    if (!_bound)
+        return;
+
+    current = _prev;
+    if (_prev)
         bind(_prev);
-        current = _prev;
-    }
 }
 
-Texture::HandleType Texture::generate_texture(HandleType &id, u32 size, u8 *buffer) {
-    glGenTextures(static_cast<GLsizei>(size), &id);
+Texture::HandleType Texture::generate_texture(HandleType &id, const void *buffer) {
+    id = ResourceManager::acquire(ResourceManager::Type::Texture, _resource);
 
     Texture::ScopeBind texture_bind(this);
 
@@ -86,10 +298,133 @@ Texture::HandleType Texture::generate_texture(HandleType &id, u32 size, u8 *buff
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, _width, _height, 0, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
+    // grayscale sources are expanded by the sampler so shaders keep reading rgba
+    if (_channels == 1) {
+        GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    } else if (_channels == 2) {
+        GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_GREEN };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+
+    specify(buffer);
 
     return id;
 }
 
+void Texture::specify(const void *buffer) {
+    ContextOwner::check();
+
+    ScopeUnit unit(_id);
+
+    auto description = describe_format(_format);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, description.internal_format, _width, _height, 0, description.format, description.type, buffer);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    const u64 size = get_memory_size();
+    MemoryTracker::record_gpu(MemoryTag::Textures, static_cast<s64>(size) - static_cast<s64>(_gpu_size));
+    _gpu_size = size;
+}
+
+void Texture::evict() {
+    ContextOwner::check();
+
+    auto description = describe_format(_format);
+
+    // not a scope bind, it could skip the bind or touch the residency that is evicting this texture
+    {
+        ScopeUnit unit(_id);
+        glTexImage2D(GL_TEXTURE_2D, 0, description.internal_format, 0, 0, 0, description.format, description.type, 0);
+    }
+
+    MemoryTracker::record_gpu(MemoryTag::Textures, -static_cast<s64>(_gpu_size));
+    _gpu_size = 0;
+}
+
+bool Texture::reload() {
+    if (_source.empty())
+        return false;
+
+    MemoryTracker::ScopeTag tag(MemoryTag::Textures);
+
+    auto data = read_file(_source);
+
+    // checked up front, load() would already have resized the object away from its storage
+    int width = 0, height = 0;
+    Format format = _format;
+
+    if (!describe_image(data.data(), data.size(), width, height, format))
+        throw Exceptions::misbehavior("failed to load image");
+    if (width != _width || height != _height || format != _format)
+        throw Exceptions::misbehavior("texture source changed since it was loaded");
+
+    load(data.data(), data.size());
+
+    return true;
+}
+
+void Texture::load(const u8 *data, u64 size) {
+    Qoi::Description qoi;
+    Lz4::Description lz4;
+
+    auto allocate = [this](const void *buffer) {
+        if (_id)
+            specify(buffer);
+        else
+            generate_texture(_id, buffer);
+    };
+
+    if (Qoi::read_header(data, size, qoi)) {
+        _width = static_cast<int>(qoi.width), _height = static_cast<int>(qoi.height), _channels = qoi.channels;
+        _format = _channels == 4 ? Format::RGBA8 : Format::RGB8;
+        allocate(0);
+
+        u64 bytes = static_cast<u64>(_width) * _height * get_pixel_size();
+        unpack_buffer pixel_buffer(bytes);
+        Qoi::decode(data, size, pixel_buffer.map(bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT), _flip);
+        pixel_buffer.unmap();
+
+        upload(Point2i(0, 0), get_size(), 0);
+    } else if (Lz4::read_header(data, size, lz4)) {
+        _width = static_cast<int>(lz4.width), _height = static_cast<int>(lz4.height), _format = lz4.format;
+        _channels = static_cast<int>(static_cast<u32>(_format) % 4 + 1);
+        allocate(0);
+
+        // lz4 matches and the flip read back decoded bytes, which has to happen in cached memory and not
+        // in a write combined mapping. the result then goes over in one sequential copy
+        u64 bytes = static_cast<u64>(_width) * _height * get_pixel_size();
+        std::vector<u8> pixels(static_cast<size_t>(bytes));
+        Lz4::decode(data, size, pixels.data(), _flip);
+
+        unpack_buffer pixel_buffer(bytes);
+        std::memcpy(pixel_buffer.map(bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT), pixels.data(), static_cast<size_t>(bytes));
+        pixel_buffer.unmap();
+
+        upload(Point2i(0, 0), get_size(), 0);
+    } else {
+        stbi_set_flip_vertically_on_load(static_cast<int>(_flip));
+
+        auto buffer = load_image(image_memory { data, static_cast<int>(size) }, _width, _height, _channels, _format);
+
+        allocate(buffer);
+
+        stbi_image_free(buffer);
+    }
+}
+
+void Texture::upload(Point2i position, Point2i size, const void *buffer, u32 row_length) {
+    Texture::ScopeBind texture_bind(this);
+
+    auto description = describe_format(_format);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(row_length));
+    glTexSubImage2D(GL_TEXTURE_2D, 0, position.x, position.y, size.x, size.y, description.format, description.type, buffer);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
 UNIFIED_GRAPHICS_END_NAMESPACE
 UNIFIED_END_NAMESPACE
@@ -0,0 +1,148 @@
+#include <unified/graphics/texture_residency.hpp>
+#include <unified/core/exceptions.hpp>
+
+UNIFIED_BEGIN_NAMESPACE
+UNIFIED_GRAPHICS_BEGIN_NAMESPACE
+
+// entries start at 0, so nothing counts as bound before the first draw
+u64 TextureResidency::_draw = 1;
+
+TextureResidency::TextureResidency(u64 budget)
+    : _budget(budget), _resident_size(0), _evictions(0), _restores(0), _busy(false) { }
+
+TextureResidency::~TextureResidency() {
+    _busy = true;
+    for (auto &entry : _entries) {
+        if (!entry.resident)
+            restore(entry);
+        entry.texture->_residency = 0;
+    }
+}
+
+void TextureResidency::manage(Texture *texture) {
+    if (!texture)
+        throw Exceptions::misbehavior("bad " UNIFIED_GRAPHICS_NAMESPACE_STRING "::Texture pointer");
+
+    if (texture->_residency == this)
+        return;
+
+    if (texture->_residency)
+        texture->_residency->release(texture);
+
+    _entries.push_front(Entry { texture, true, 0, { } });
+    _lookup[texture] = _entries.begin();
+    _resident_size += texture->get_memory_size();
+
+    texture->_residency = this;
+
+    enforce(texture);
+}
+
+void TextureResidency::release(Texture *texture) {
+    auto found = _lookup.find(texture);
+    if (found == _lookup.end())
+        return;
+
+    auto entry = found->second;
+    if (entry->resident)
+        _resident_size -= texture->get_memory_size();
+
+    texture->_residency = 0;
+
+    _entries.erase(entry);
+    _lookup.erase(found);
+}
+
+void TextureResidency::touch(const Texture *texture) {
+    if (_busy)
+        return;
+
+    auto found = _lookup.find(texture);
+    if (found == _lookup.end())
+        return;
+
+    auto entry = found->second;
+    if (entry != _entries.begin())
+        _entries.splice(_entries.begin(), _entries, entry);
+    entry->bound_in = _draw;
+
+    if (!entry->resident) {
+        _busy = true;
+        restore(*entry);
+        enforce(texture);
+        _busy = false;
+    }
+}
+
+void TextureResidency::next_draw() {
+    ++_draw;
+}
+
+UNIFIED_NODISCARD bool TextureResidency::is_resident(const Texture *texture) const {
+    auto found = _lookup.find(texture);
+    return found == _lookup.end() || found->second->resident;
+}
+
+UNIFIED_NODISCARD u64 TextureResidency::get_budget() const {
+    return _budget;
+}
+
+void TextureResidency::set_budget(u64 budget) {
+    _budget = budget;
+    enforce(0);
+}
+
+UNIFIED_NODISCARD u64 TextureResidency::get_resident_size() const {
+    return _resident_size;
+}
+
+UNIFIED_NODISCARD u32 TextureResidency::get_evictions() const {
+    return _evictions;
+}
+
+UNIFIED_NODISCARD u32 TextureResidency::get_restores() const {
+    return _restores;
+}
+
+void TextureResidency::evict(Entry &entry) {
+    Texture *texture = entry.texture;
+
+    // textures without a file to reload from are kept as a cpu side copy
+    if (texture->_source.empty()) {
+        entry.cache.resize(static_cast<size_t>(texture->_width) * texture->_height * texture->get_pixel_size());
+        texture->read(entry.cache.data());
+    }
+
+    texture->evict();
+
+    entry.resident = false;
+    _resident_size -= texture->get_memory_size();
+    ++_evictions;
+}
+
+void TextureResidency::restore(Entry &entry) {
+    Texture *texture = entry.texture;
+
+    if (!texture->reload()) {
+        texture->specify(entry.cache.data());
+        entry.cache = std::vector<u8>();
+    }
+
+    entry.resident = true;
+    _resident_size += texture->get_memory_size();
+    ++_restores;
+}
+
+void TextureResidency::enforce(const Texture *keep) {
+    bool busy = _busy;
+    _busy = true;
+
+    for (auto it = _entries.rbegin(); it != _entries.rend() && _resident_size > _budget; ++it)
+        if (it->resident && it->texture != keep && it->bound_in != _draw)
+            evict(*it);
+
+    _busy = busy;
+}
+
+UNIFIED_GRAPHICS_END_NAMESPACE
+UNIFIED_END_NAMESPACE
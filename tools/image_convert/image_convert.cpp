@@ -0,0 +1,91 @@
+#include <unified/graphics/image/qoi.hpp>
+#include <unified/graphics/image/lz4.hpp>
+
+#include <stb_image.h>
+#include <fmt/format.h>
+
+#include <fstream>
+#include <cstring>
+
+using namespace Unified;
+using namespace Unified::Graphics;
+
+namespace
+{
+    bool ends_with(const string &value, const string &suffix) {
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    bool write_file(const string &path, const std::vector<u8> &data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        return file && file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    int convert_qoi(const string &input, const string &output) {
+        int width, height, channels;
+        if (!stbi_info(input.c_str(), &width, &height, &channels))
+            return fmt::print(stderr, "failed to read {}: {}\n", input, stbi_failure_reason()), 1;
+
+        // qoi only stores 8 bit rgb and rgba, grayscale sources are expanded
+        int desired = (channels == 1 || channels == 3) ? 3 : 4;
+
+        auto pixels = stbi_load(input.c_str(), &width, &height, &channels, desired);
+        if (!pixels)
+            return fmt::print(stderr, "failed to load {}: {}\n", input, stbi_failure_reason()), 1;
+
+        Qoi::Description description { static_cast<u32>(width), static_cast<u32>(height), static_cast<u8>(desired), 0 };
+        auto encoded = Qoi::encode(pixels, description);
+        stbi_image_free(pixels);
+
+        if (!write_file(output, encoded))
+            return fmt::print(stderr, "failed to write {}\n", output), 1;
+
+        fmt::print("{} -> {} ({}x{}, {} channels, {} bytes)\n", input, output, width, height, desired, encoded.size());
+        return 0;
+    }
+
+    int convert_lz4(const string &input, const string &output) {
+        int width, height, channels;
+        void *pixels;
+        u32 depth;
+
+        if (stbi_is_hdr(input.c_str()))
+            pixels = stbi_loadf(input.c_str(), &width, &height, &channels, 0), depth = 2;
+        else if (stbi_is_16_bit(input.c_str()))
+            pixels = stbi_load_16(input.c_str(), &width, &height, &channels, 0), depth = 1;
+        else
+            pixels = stbi_load(input.c_str(), &width, &height, &channels, 0), depth = 0;
+
+        if (!pixels)
+            return fmt::print(stderr, "failed to load {}: {}\n", input, stbi_failure_reason()), 1;
+
+        Lz4::Description description { static_cast<u32>(width), static_cast<u32>(height),
+            static_cast<Texture::Format>(depth * 4 + static_cast<u32>(channels - 1)) };
+        auto encoded = Lz4::encode(static_cast<const u8*>(pixels), description);
+        stbi_image_free(pixels);
+
+        if (!write_file(output, encoded))
+            return fmt::print(stderr, "failed to write {}\n", output), 1;
+
+        fmt::print("{} -> {} ({}x{}, {} channels, {} bytes)\n", input, output, width, height, channels, encoded.size());
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fmt::print(stderr, "usage: {} <input image> <output.qoi | output.ulz4>\n", argv[0]);
+        return 1;
+    }
+
+    string input = argv[1], output = argv[2];
+
+    if (ends_with(output, ".qoi"))
+        return convert_qoi(input, output);
+
+    if (ends_with(output, ".ulz4"))
+        return convert_lz4(input, output);
+
+    fmt::print(stderr, "unknown output format for {}, expected .qoi or .ulz4\n", output);
+    return 1;
+}